@@ -3,6 +3,8 @@ CREATE TABLE IF NOT EXISTS `beastmaster_tamed_pets` (
     `entry`      INT UNSIGNED NOT NULL,
     `name`       VARCHAR(32)  NOT NULL,
     `date_tamed` TIMESTAMP     NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    `last_summoned` INT UNSIGNED NOT NULL DEFAULT 0,
     PRIMARY KEY (`owner_guid`, `entry`),
-    KEY `idx_beastmaster_tamed_pets_owner_guid` (`owner_guid`)
+    KEY `idx_beastmaster_tamed_pets_owner_guid` (`owner_guid`),
+    KEY `idx_beastmaster_tamed_pets_owner_date` (`owner_guid`, `date_tamed`, `entry`)
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
\ No newline at end of file
@@ -0,0 +1,20 @@
+-- ############################################################
+-- Beastmaster: keyset pagination index for tracked pets
+-- Supports BeastMaster.TrackedPetsKeysetPaging (ORDER BY date_tamed DESC,
+-- entry DESC with a (date_tamed, entry) cursor per owner).
+-- Table: beastmaster_tamed_pets
+-- ############################################################
+
+SET @idx_exists := (
+    SELECT COUNT(*) FROM information_schema.STATISTICS
+    WHERE TABLE_SCHEMA = DATABASE()
+      AND TABLE_NAME = 'beastmaster_tamed_pets'
+      AND INDEX_NAME = 'idx_beastmaster_tamed_pets_owner_date');
+
+SET @sql := IF(@idx_exists = 0,
+    'ALTER TABLE `beastmaster_tamed_pets` ADD KEY `idx_beastmaster_tamed_pets_owner_date` (`owner_guid`, `date_tamed`, `entry`)',
+    'DO 0');
+
+PREPARE stmt FROM @sql;
+EXECUTE stmt;
+DEALLOCATE PREPARE stmt;
@@ -0,0 +1,20 @@
+-- ############################################################
+-- Beastmaster: last summon time for the "Last Summoned" order
+-- Unix epoch, 0 = never summoned. Written back when the player
+-- logs out.
+-- Table: beastmaster_tamed_pets
+-- ############################################################
+
+SET @col_exists := (
+    SELECT COUNT(*) FROM information_schema.COLUMNS
+    WHERE TABLE_SCHEMA = DATABASE()
+      AND TABLE_NAME = 'beastmaster_tamed_pets'
+      AND COLUMN_NAME = 'last_summoned');
+
+SET @sql := IF(@col_exists = 0,
+    'ALTER TABLE `beastmaster_tamed_pets` ADD COLUMN `last_summoned` INT UNSIGNED NOT NULL DEFAULT 0 AFTER `date_tamed`',
+    'DO 0');
+
+PREPARE stmt FROM @sql;
+EXECUTE stmt;
+DEALLOCATE PREPARE stmt;
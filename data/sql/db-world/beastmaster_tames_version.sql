@@ -0,0 +1,31 @@
+-- ############################################################
+-- Beastmaster: change marker for beastmaster_tames
+-- Lets the catalog cache and BeastMaster.CatalogPollInterval
+-- detect edits with one primary key lookup instead of
+-- CHECKSUM TABLE.
+-- Tables: beastmaster_tames_version, beastmaster_tames (triggers)
+-- ############################################################
+
+-- Change marker for beastmaster_tames. The module compares it instead of
+-- scanning the table to validate its catalog cache and to poll for edits.
+-- Seeded from the clock so a recreated table never repeats an old version.
+-- Row triggers miss TRUNCATE and imports run with triggers disabled; run
+-- .beastmaster reload afterwards, which bumps the version itself.
+CREATE TABLE IF NOT EXISTS `beastmaster_tames_version` (
+    `id` TINYINT UNSIGNED NOT NULL PRIMARY KEY,
+    `version` BIGINT UNSIGNED NOT NULL
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
+
+INSERT IGNORE INTO `beastmaster_tames_version` (`id`, `version`) VALUES (1, UNIX_TIMESTAMP() * 1000);
+
+DROP TRIGGER IF EXISTS `beastmaster_tames_ai`;
+CREATE TRIGGER `beastmaster_tames_ai` AFTER INSERT ON `beastmaster_tames` FOR EACH ROW
+    UPDATE `beastmaster_tames_version` SET `version` = `version` + 1 WHERE `id` = 1;
+
+DROP TRIGGER IF EXISTS `beastmaster_tames_au`;
+CREATE TRIGGER `beastmaster_tames_au` AFTER UPDATE ON `beastmaster_tames` FOR EACH ROW
+    UPDATE `beastmaster_tames_version` SET `version` = `version` + 1 WHERE `id` = 1;
+
+DROP TRIGGER IF EXISTS `beastmaster_tames_ad`;
+CREATE TRIGGER `beastmaster_tames_ad` AFTER DELETE ON `beastmaster_tames` FOR EACH ROW
+    UPDATE `beastmaster_tames_version` SET `version` = `version` + 1 WHERE `id` = 1;
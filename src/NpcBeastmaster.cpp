@@ -21,19 +21,35 @@
 #include "ChatCommand.h"
 #include "Common.h"
 #include "Config.h"
+#include "DBCStores.h"
 #include "Pet.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "ScriptedCreature.h"
 #include "ScriptedGossip.h"
 #include "WorldSession.h"
+#include <charconv>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <locale>
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <numeric>
 #include <regex>
 #include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <sys/stat.h>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -47,21 +63,14 @@ static uint32 GetBeastmasterNpcEntry()
 
 namespace BeastmasterDB
 {
-  bool TrackTamedPet(Player *player, uint32 creatureEntry,
-                     std::string const &petName)
+  // Queued on the async character DB worker. Callers rule out duplicates from
+  // the cached entries first; IGNORE covers a race with another session.
+  void TrackTamedPet(Player *player, uint32 creatureEntry, std::string petName)
   {
-    QueryResult result =
-        CharacterDatabase.Query("SELECT 1 FROM beastmaster_tamed_pets WHERE "
-                                "owner_guid = {} AND entry = {}",
-                                player->GetGUID().GetCounter(), creatureEntry);
-    if (result)
-      return false; // Already tracked
-
-    CharacterDatabase.Execute("INSERT INTO beastmaster_tamed_pets (owner_guid, "
-                              "entry, name) VALUES ({}, {}, '{}')",
-                              player->GetGUID().GetCounter(), creatureEntry,
-                              petName.c_str());
-    return true;
+    CharacterDatabase.EscapeString(petName);
+    CharacterDatabase.Execute("INSERT IGNORE INTO beastmaster_tamed_pets (owner_guid, "
+                              "entry, name, last_summoned) VALUES ({}, {}, '{}', UNIX_TIMESTAMP())",
+                              player->GetGUID().GetCounter(), creatureEntry, petName);
   }
 } // namespace BeastmasterDB
 
@@ -69,6 +78,503 @@ namespace
 {
   using PetList = std::vector<PetInfo>;
 
+  // --- Gossip action codec ------------------------------------------------
+  // Action word layout: | op:4 | category:2 | page:10 | index:16 |
+  // Adopt and the tracked pet actions store the creature entry in the low 28
+  // bits instead, so they need no per-menu lookup table. Op 0 carries raw core
+  // option codes (vendor, stable) and 0 for "no action", so encoded actions
+  // never collide with them.
+  enum class ActionOp : uint8
+  {
+    Raw = 0,
+    MainMenu,
+    Browse,
+    Adopt,
+    RemoveSkills,
+    TrackedMenu,
+    TrackedSummon,
+    TrackedRename,
+    TrackedDelete,
+    Search,
+    Family,
+    Letters,
+    Nearby,
+    Count
+  };
+
+  enum class PetCategory : uint8
+  {
+    Normal = 0,
+    Exotic,
+    Rare,
+    RareExotic,
+    Count
+  };
+
+  struct GossipAction
+  {
+    static constexpr uint32 OpShift = 28;
+    static constexpr uint32 CategoryShift = 26;
+    static constexpr uint32 PageShift = 16;
+    static constexpr uint32 CategoryMask = 0x3;
+    static constexpr uint32 PageMask = 0x3FF;
+    static constexpr uint32 IndexMask = 0xFFFF;
+    static constexpr uint32 WideMask = 0x0FFFFFFF; // Raw / Adopt payload
+    static constexpr uint32 MaxPage = PageMask;
+
+    ActionOp op = ActionOp::Raw;
+    PetCategory category = PetCategory::Normal;
+    uint32 page = 0;
+    uint32 index = 0; // entry for wide ops, core option code for Raw
+
+    static constexpr bool IsWide(ActionOp op)
+    {
+      return op == ActionOp::Raw || op == ActionOp::Adopt ||
+             op == ActionOp::TrackedSummon || op == ActionOp::TrackedRename ||
+             op == ActionOp::TrackedDelete;
+    }
+
+    constexpr uint32 Encode() const
+    {
+      uint32 word = uint32(op) << OpShift;
+      if (IsWide(op))
+        return word | (index & WideMask);
+      return word | ((uint32(category) & CategoryMask) << CategoryShift) |
+             ((page & PageMask) << PageShift) | (index & IndexMask);
+    }
+
+    static constexpr GossipAction Decode(uint32 word)
+    {
+      GossipAction a;
+      a.op = ActionOp(word >> OpShift);
+      if (IsWide(a.op))
+      {
+        a.index = word & WideMask;
+        return a;
+      }
+      a.category = PetCategory((word >> CategoryShift) & CategoryMask);
+      a.page = (word >> PageShift) & PageMask;
+      a.index = word & IndexMask;
+      return a;
+    }
+
+    static constexpr ActionOp OpOf(uint32 word) { return ActionOp(word >> OpShift); }
+
+    constexpr bool operator==(GossipAction const &o) const
+    {
+      return op == o.op && category == o.category && page == o.page &&
+             index == o.index;
+    }
+
+    // Factories for the action words placed in gossip menus.
+    static constexpr uint32 Simple(ActionOp op) { return GossipAction{op}.Encode(); }
+    static constexpr uint32 Browse(PetCategory c, uint32 page)
+    {
+      return GossipAction{ActionOp::Browse, c, page}.Encode();
+    }
+    static constexpr uint32 Adopt(uint32 entry)
+    {
+      return GossipAction{ActionOp::Adopt, PetCategory::Normal, 0, entry}.Encode();
+    }
+    // sort 0 keeps the player's current order, otherwise TrackedSort + 1.
+    static constexpr uint32 TrackedPage(uint32 page, uint32 sort = 0)
+    {
+      return GossipAction{ActionOp::TrackedMenu, PetCategory::Normal, page, sort}.Encode();
+    }
+    static constexpr uint32 TrackedPet(ActionOp op, uint32 entry)
+    {
+      return GossipAction{op, PetCategory::Normal, 0, entry}.Encode();
+    }
+    static constexpr uint32 SearchPage(uint32 page)
+    {
+      return GossipAction{ActionOp::Search, PetCategory::Normal, page}.Encode();
+    }
+    // Family 0 is the family list itself.
+    static constexpr uint32 FamilyList(uint32 page)
+    {
+      return GossipAction{ActionOp::Family, PetCategory::Normal, page}.Encode();
+    }
+    static constexpr uint32 FamilyPets(uint32 family, uint32 page)
+    {
+      return GossipAction{ActionOp::Family, PetCategory::Normal, page, family}.Encode();
+    }
+    // Letter menu for a category; page is the browse page to return to. A
+    // non-zero letter (1 + its slot in CategoryOrder::letters) lists the
+    // pages that letter spans instead.
+    static constexpr uint32 Letters(PetCategory category, uint32 page, uint32 letter = 0)
+    {
+      return GossipAction{ActionOp::Letters, category, page, letter}.Encode();
+    }
+    static constexpr uint32 NearbyPage(uint32 page)
+    {
+      return GossipAction{ActionOp::Nearby, PetCategory::Normal, page}.Encode();
+    }
+  };
+
+  // Compile-time check that every opcode round-trips through the codec at the
+  // edges of each field.
+  constexpr bool GossipActionCodecRoundTrips()
+  {
+    constexpr uint32 pages[] = {0, 1, 2, 100, GossipAction::MaxPage};
+    constexpr uint32 indices[] = {0, 1, 12, 901, GossipAction::IndexMask};
+    constexpr uint32 wide[] = {0, 3, 14, 601026, GossipAction::WideMask};
+    for (uint8 op = 0; op < uint8(ActionOp::Count); ++op)
+    {
+      if (GossipAction::IsWide(ActionOp(op)))
+      {
+        for (uint32 w : wide)
+        {
+          GossipAction a{ActionOp(op), PetCategory::Normal, 0, w};
+          if (!(GossipAction::Decode(a.Encode()) == a))
+            return false;
+        }
+        continue;
+      }
+      for (uint8 c = 0; c < uint8(PetCategory::Count); ++c)
+        for (uint32 p : pages)
+          for (uint32 i : indices)
+          {
+            GossipAction a{ActionOp(op), PetCategory(c), p, i};
+            if (!(GossipAction::Decode(a.Encode()) == a) ||
+                GossipAction::OpOf(a.Encode()) != a.op)
+              return false;
+          }
+    }
+    return true;
+  }
+  static_assert(GossipActionCodecRoundTrips(), "gossip action codec broken");
+
+  // Pre-built main menu option, replayed verbatim into the menu. Coded items
+  // open the client's text box and come back through OnGossipSelectCode.
+  struct MainMenuEntry
+  {
+    uint32 icon;
+    std::string text;
+    uint32 action;
+    bool coded = false;
+  };
+
+  static constexpr char const *SearchPrompt = "Enter the start of a pet's name.";
+
+  // Main menu variants indexed by MainMenuSignature() (hunter, exotic access,
+  // can unlearn). Tracking on/off is part of the config they were built from.
+  static constexpr size_t MainMenuVariantCount = 8;
+  using MainMenuVariants =
+      std::array<std::vector<MainMenuEntry>, MainMenuVariantCount>;
+
+  // Compact tracked pet record (32 bytes, no heap). Custom names are capped at
+  // 16 characters by IsValidPetName and stored inline; a pet that still has
+  // its creature name stores nothing and resolves it from the catalog.
+  struct TrackedPetRecord
+  {
+    static constexpr size_t MaxNameLen = 16;
+
+    uint32 entry = 0;
+    uint32 tamedAt = 0;    // unix epoch
+    uint32 summonedAt = 0; // unix epoch, 0 = never summoned
+    uint8 nameLen = 0;     // 0 = default (catalog) name
+    char name[MaxNameLen] = {};
+
+    TrackedPetRecord() = default;
+    TrackedPetRecord(uint32 e, uint32 t, std::string_view n,
+                     std::string_view defaultName)
+        : entry(e), tamedAt(t)
+    {
+      if (n != defaultName)
+        SetName(n);
+    }
+
+    bool HasCustomName() const { return nameLen != 0; }
+    std::string_view CustomName() const { return {name, nameLen}; }
+
+    // Names longer than the buffer can only be creature defaults, so they
+    // fall back to the catalog name rather than being truncated.
+    void SetName(std::string_view n)
+    {
+      nameLen = n.size() <= MaxNameLen ? uint8(n.size()) : 0;
+      std::memcpy(name, n.data(), nameLen);
+    }
+  };
+
+  // Sorted orders come first; Recent is kept as a linked list instead.
+  enum class TrackedSort : uint8
+  {
+    Date = 0, // newest first
+    Name,
+    Family,
+    Rarity,
+    Recent, // most recently summoned (or adopted) first
+    Count
+  };
+
+  // Per-record keys for the non-date orders, derived from the record and the
+  // catalog whenever the record is added or renamed.
+  struct TrackedSortFields
+  {
+    std::string nameKey; // CollationKey of the shown name
+    uint32 family = 0;
+    uint8 rarityRank = 0; // rare exotic first, unknown pets last
+  };
+
+  // One player's tracked pets. Records are stored unordered (deletes
+  // swap-remove); every sorted TrackedSort is a permutation of record indices
+  // that is kept sorted as pets are added, renamed and deleted, so switching
+  // orders neither queries nor re-sorts. Ties fall back to the date order.
+  // Recent is an intrusive doubly linked list over the same indices: a summon
+  // moves its pet to the front in O(1) and marks it for the next Flush.
+  class TrackedPetList
+  {
+  public:
+    using Fields = TrackedSortFields;
+
+    void Assign(std::vector<TrackedPetRecord> records, std::vector<Fields> keys)
+    {
+      pets = std::move(records);
+      fields = std::move(keys);
+      indexByEntry.clear();
+      for (uint32 i = 0; i < pets.size(); ++i)
+        indexByEntry[pets[i].entry] = i;
+
+      std::vector<uint32> order(pets.size());
+      for (size_t s = 0; s <= orders.size(); ++s)
+      {
+        for (uint32 i = 0; i < order.size(); ++i)
+          order[i] = i;
+        std::sort(order.begin(), order.end(), [&](uint32 a, uint32 b)
+                  { return Less(TrackedSort(s), a, b); });
+        if (s < orders.size())
+          orders[s] = order;
+      }
+
+      // order now holds the Recent order; chain it.
+      links.assign(pets.size(), {});
+      head = tail = Nil;
+      for (auto it = order.rbegin(); it != order.rend(); ++it)
+        PushFront(*it);
+    }
+
+    // Adds a newly adopted pet. Adopting summons it, so it leads the Recent
+    // order with its summon time pending write-back like any other summon.
+    void Insert(TrackedPetRecord const &rec, Fields keys)
+    {
+      uint32 i = uint32(pets.size());
+      pets.push_back(rec);
+      if (!pets[i].summonedAt)
+        pets[i].summonedAt = rec.tamedAt;
+      fields.push_back(std::move(keys));
+      links.push_back({});
+      indexByEntry[rec.entry] = i;
+      dirty.insert(rec.entry);
+      Link(i);
+      PushFront(i);
+    }
+
+    bool Erase(uint32 entry)
+    {
+      int32 i = IndexOf(entry);
+      if (i < 0)
+        return false;
+      uint32 last = uint32(pets.size() - 1);
+      Unlink(uint32(i));
+      Detach(uint32(i));
+      dirty.erase(entry);
+      indexByEntry.erase(entry);
+      if (uint32(i) != last)
+      {
+        // The last record moves into the hole; renumber it in place.
+        for (size_t s = 0; s < orders.size(); ++s)
+          *Locate(TrackedSort(s), last) = uint32(i);
+        RecentLink moved = links[last];
+        (moved.prev != Nil ? links[moved.prev].next : head) = uint32(i);
+        (moved.next != Nil ? links[moved.next].prev : tail) = uint32(i);
+        links[i] = moved;
+        pets[i] = pets[last];
+        fields[i] = std::move(fields[last]);
+        indexByEntry[pets[i].entry] = uint32(i);
+      }
+      pets.pop_back();
+      fields.pop_back();
+      links.pop_back();
+      return true;
+    }
+
+    // Moves the pet to the front of the Recent order.
+    bool Touch(uint32 entry, uint32 now)
+    {
+      int32 i = IndexOf(entry);
+      if (i < 0)
+        return false;
+      pets[i].summonedAt = now;
+      dirty.insert(entry);
+      Detach(uint32(i));
+      PushFront(uint32(i));
+      return true;
+    }
+
+    // Summon times not yet written back, as (entry, summonedAt); clears them.
+    std::vector<std::pair<uint32, uint32>> Flush()
+    {
+      std::vector<std::pair<uint32, uint32>> out;
+      out.reserve(dirty.size());
+      for (uint32 entry : dirty)
+        out.emplace_back(entry, pets[indexByEntry.at(entry)].summonedAt);
+      dirty.clear();
+      return out;
+    }
+
+    // Applies fn(record, fields) and moves the record to its new positions.
+    template <typename Fn>
+    bool Update(uint32 entry, Fn &&fn)
+    {
+      int32 i = IndexOf(entry);
+      if (i < 0)
+        return false;
+      Unlink(uint32(i));
+      fn(pets[i], fields[i]);
+      Link(uint32(i));
+      return true;
+    }
+
+    TrackedPetRecord const *Find(uint32 entry) const
+    {
+      int32 i = IndexOf(entry);
+      return i < 0 ? nullptr : &pets[i];
+    }
+
+    size_t size() const { return pets.size(); }
+
+    // Appends up to count records starting at pos of the given order.
+    void Page(TrackedSort sort, size_t pos, size_t count,
+              std::vector<TrackedPetRecord> &out) const
+    {
+      if (sort == TrackedSort::Recent)
+      {
+        uint32 i = head;
+        for (; i != Nil && pos; --pos)
+          i = links[i].next;
+        for (; i != Nil && count; --count, i = links[i].next)
+          out.push_back(pets[i]);
+        return;
+      }
+      auto const &order = orders[size_t(sort)];
+      for (size_t end = std::min(pos + count, order.size()); pos < end; ++pos)
+        out.push_back(pets[order[pos]]);
+    }
+
+    // Position of the entry in the given order, or -1.
+    int32 PositionOf(TrackedSort sort, uint32 entry) const
+    {
+      int32 i = IndexOf(entry);
+      if (i < 0)
+        return -1;
+      if (sort == TrackedSort::Recent)
+      {
+        int32 pos = 0;
+        for (uint32 j = head; j != uint32(i); j = links[j].next)
+          ++pos;
+        return pos;
+      }
+      auto const &order = orders[size_t(sort)];
+      return int32(std::lower_bound(order.begin(), order.end(), uint32(i),
+                                    [&](uint32 a, uint32 b)
+                                    { return Less(sort, a, b); }) -
+                   order.begin());
+    }
+
+  private:
+    bool Less(TrackedSort sort, uint32 a, uint32 b) const
+    {
+      Fields const &fa = fields[a];
+      Fields const &fb = fields[b];
+      switch (sort)
+      {
+      case TrackedSort::Name:
+        if (fa.nameKey != fb.nameKey)
+          return fa.nameKey < fb.nameKey;
+        break;
+      case TrackedSort::Family:
+        if (fa.family != fb.family)
+          return fa.family < fb.family;
+        break;
+      case TrackedSort::Rarity:
+        if (fa.rarityRank != fb.rarityRank)
+          return fa.rarityRank < fb.rarityRank;
+        break;
+      case TrackedSort::Recent:
+        if (pets[a].summonedAt != pets[b].summonedAt)
+          return pets[a].summonedAt > pets[b].summonedAt;
+        break;
+      default:
+        break;
+      }
+      return std::tie(pets[a].tamedAt, pets[a].entry) >
+             std::tie(pets[b].tamedAt, pets[b].entry);
+    }
+
+    std::vector<uint32>::iterator Locate(TrackedSort sort, uint32 i)
+    {
+      auto &order = orders[size_t(sort)];
+      return std::lower_bound(order.begin(), order.end(), i,
+                              [&](uint32 a, uint32 b)
+                              { return Less(sort, a, b); });
+    }
+
+    void Link(uint32 i)
+    {
+      for (size_t s = 0; s < orders.size(); ++s)
+      {
+        auto &order = orders[s];
+        order.insert(std::upper_bound(order.begin(), order.end(), i,
+                                      [&](uint32 a, uint32 b)
+                                      { return Less(TrackedSort(s), a, b); }),
+                     i);
+      }
+    }
+
+    void Unlink(uint32 i)
+    {
+      for (size_t s = 0; s < orders.size(); ++s)
+        orders[s].erase(Locate(TrackedSort(s), i));
+    }
+
+    void PushFront(uint32 i)
+    {
+      links[i] = {Nil, head};
+      (head != Nil ? links[head].prev : tail) = i;
+      head = i;
+    }
+
+    void Detach(uint32 i)
+    {
+      RecentLink &l = links[i];
+      (l.prev != Nil ? links[l.prev].next : head) = l.next;
+      (l.next != Nil ? links[l.next].prev : tail) = l.prev;
+      l = {};
+    }
+
+    int32 IndexOf(uint32 entry) const
+    {
+      auto it = indexByEntry.find(entry);
+      return it == indexByEntry.end() ? -1 : int32(it->second);
+    }
+
+    static constexpr uint32 Nil = std::numeric_limits<uint32>::max();
+    struct RecentLink
+    {
+      uint32 prev = Nil;
+      uint32 next = Nil;
+    };
+
+    std::vector<TrackedPetRecord> pets;
+    std::vector<Fields> fields;
+    std::unordered_map<uint32, uint32> indexByEntry;
+    std::array<std::vector<uint32>, size_t(TrackedSort::Recent)> orders;
+    std::vector<RecentLink> links; // Recent order
+    uint32 head = Nil;
+    uint32 tail = Nil;
+    std::unordered_set<uint32> dirty; // entries summoned since the last Flush
+  };
+
   // Consolidated runtime state singleton to avoid scattered globals.
   struct BeastmasterRuntime
   {
@@ -83,25 +589,285 @@ namespace
       bool hunterBeastMasteryRequired = true;
       bool trackTamedPets = false;
       uint32 maxTrackedPets = 20;
-      std::set<uint8> allowedRaces;
-      std::set<uint8> allowedClasses;
-    } config;
-
-    // Pet data
-    PetList allPets;
-    PetList normalPets;
-    PetList exoticPets;
-    PetList rarePets;
-    PetList rareExoticPets;
-    std::set<uint32> rarePetEntries;
-    std::set<uint32> rareExoticPetEntries;
-    std::unordered_map<uint32, PetInfo> allPetsByEntry;
-    std::mutex petsMutex;
+      bool trackedKeysetPaging = false;
+      uint32 trackedPrefetchPages = 2;
+      bool catalogCache = true;
+      uint32 catalogPollInterval = 0; // seconds, 0 = off
+      bool levelFilter = false;
+      bool debugSearchTiming = false;
+      std::string catalogCachePath;
+      uint32 allowedRaceMask = 0;  // bit per race id, 0 = all
+      uint32 allowedClassMask = 0; // bit per class id, 0 = all
+    };
+
+    // Precomputed adoption gate: allowed race bits per class plus the level
+    // window, so the check is a shift, a mask and one unsigned compare.
+    struct Eligibility
+    {
+      std::array<uint32, MAX_CLASSES> raceMaskByClass{};
+      uint32 minLevel = 0;
+      uint32 levelSpan = 0; // maxLevel - minLevel
+
+      bool Allows(uint8 cls, uint8 race, uint32 level) const
+      {
+        return cls < MAX_CLASSES && race < 32 &&
+               ((raceMaskByClass[cls] >> race) & 1) &&
+               level - minLevel <= levelSpan;
+      }
+    };
+
+    // Everything LoadSystem produces. Each load builds a new State on the
+    // loader thread and publishes it with a single swap; callers keep the
+    // State they loaded for the rest of the call.
+    struct State
+    {
+      Config config;
+      Eligibility eligibility;
+      MainMenuVariants mainMenus;
+
+      // Pets per PetCategory sorted by name. A reload that leaves a category
+      // unchanged shares its list with the previous State, so indices and
+      // pointers into it stay valid across the swap.
+      struct PetSlot
+      {
+        PetCategory category;
+        uint32 index;
+      };
+      using PetSlots = std::unordered_map<uint32, PetSlot>;
+
+      std::array<std::shared_ptr<PetList const>, size_t(PetCategory::Count)> pets;
+      std::shared_ptr<PetSlots const> petSlots; // entry -> position
+
+      // Name search for one client locale: one key per word start of every
+      // pet's English name and, for localized locales, of its name in that
+      // locale (NormalizeSearchKey), sorted so a prefix query is a binary
+      // search plus a forward scan; and trigram -> positions in `keys` for
+      // typo-tolerant lookups. Locales without names share the enUS index.
+      struct SearchKey
+      {
+        std::string key;
+        PetSlot slot;
+      };
+      using TrigramPostings = std::unordered_map<uint32, std::vector<uint32>>;
+      struct SearchIndex
+      {
+        std::vector<SearchKey> keys;
+        TrigramPostings trigrams;
+      };
+      std::array<std::shared_ptr<SearchIndex const>, TOTAL_LOCALES> search;
+
+      SearchIndex const *Search(LocaleConstant locale) const
+      {
+        return search[locale < TOTAL_LOCALES ? locale : LOCALE_enUS].get();
+      }
+
+      // Indices into each category list, bucketed by creature family and
+      // sorted by family id.
+      struct FamilyBucket
+      {
+        uint32 family;
+        std::array<std::vector<uint32>, size_t(PetCategory::Count)> pets;
+      };
+      std::shared_ptr<std::vector<FamilyBucket> const> families;
+
+      // Initial ('#' for non-letters) and the first position holding it in a
+      // display order; drives the jump-to-letter menu.
+      struct LetterStart
+      {
+        std::string letter; // one UTF-8 character
+        uint32 position;
+      };
+
+      static constexpr uint32 LevelBracketSize = 5;
+      static constexpr uint32 LevelBrackets = 16; // up to level 80
+      using LevelViews = std::array<std::vector<uint32>, LevelBrackets>;
+
+      // A category as one client locale lists it: positions map to list
+      // indices sorted by the names that locale shows. `levels` holds, per
+      // level bracket, the positions of pets whose creature_template minlevel
+      // does not exceed the bracket's top level (the last bracket takes every
+      // pet), and `letters` where each initial starts. enUS and locales
+      // without names use the list's own order (empty `order`, position ==
+      // index). Shared with the previous State while the list and the
+      // locale's names are unchanged.
+      struct CategoryOrder
+      {
+        std::vector<uint32> order; // position -> list index
+        std::vector<uint32> rank;  // list index -> position
+        LevelViews levels;
+        std::vector<LetterStart> letters;
+
+        uint32 IndexAt(uint32 position) const
+        {
+          return order.empty() ? position : order[position];
+        }
+        uint32 PositionOf(uint32 index) const
+        {
+          return rank.empty() ? index : rank[index];
+        }
+      };
+      using CategoryOrders = std::array<std::shared_ptr<CategoryOrder const>, size_t(PetCategory::Count)>;
+      std::array<CategoryOrders, TOTAL_LOCALES> orders;
+
+      CategoryOrder const &Order(PetCategory c, LocaleConstant locale) const
+      {
+        static CategoryOrder const empty;
+        auto const &order = orders[locale < TOTAL_LOCALES ? locale : LOCALE_enUS][size_t(c)];
+        return order ? *order : empty;
+      }
+
+      // Positions of `order` offered to a player of this level, or null when
+      // level filtering is off and the whole order applies.
+      std::vector<uint32> const *LevelView(CategoryOrder const &order, uint32 level) const
+      {
+        if (!config.levelFilter)
+          return nullptr;
+        uint32 bracket = level ? (level - 1) / LevelBracketSize : 0;
+        return &order.levels[std::min(bracket, LevelBrackets - 1)];
+      }
+
+      // Catalog entries spawned in `creature`, sorted and unique per key:
+      // by zone, and by map grid cell (SpawnCellKey) for spawns whose zone
+      // was never recorded. Rebuilt on every load and catalog refresh.
+      struct SpawnIndex
+      {
+        std::unordered_map<uint32, std::vector<uint32>> byZone;
+        std::unordered_map<uint32, std::vector<uint32>> byCell;
+      };
+      std::shared_ptr<SpawnIndex const> spawns;
+
+      // Catalog names from creature_template_locale: per DB locale, one
+      // string arena holding each name and its CollationKey, plus entry ->
+      // span. Locales without rows stay null and entries without a row fall
+      // back to PetInfo::name.
+      struct LocalizedNames
+      {
+        struct Span
+        {
+          uint32 offset;
+          uint32 length;
+          uint32 keyLength; // key follows the name in the arena
+
+          bool operator==(Span const &) const = default;
+        };
+        std::string arena;
+        std::unordered_map<uint32, Span> spans;
+
+        bool operator==(LocalizedNames const &) const = default;
+      };
+      std::array<std::shared_ptr<LocalizedNames const>, TOTAL_LOCALES> localeNames;
+
+      std::string_view PetName(PetInfo const &pet, LocaleConstant locale) const
+      {
+        if (LocalizedNames::Span const *span = LocalizedSpan(pet, locale))
+          return std::string_view(localeNames[locale]->arena).substr(span->offset, span->length);
+        return pet.name;
+      }
+
+      // Sort key of PetName(pet, locale).
+      std::string_view PetSortKey(PetInfo const &pet, LocaleConstant locale) const
+      {
+        if (LocalizedNames::Span const *span = LocalizedSpan(pet, locale))
+          return std::string_view(localeNames[locale]->arena)
+              .substr(span->offset + span->length, span->keyLength);
+        return pet.sortKey;
+      }
+
+      LocalizedNames::Span const *LocalizedSpan(PetInfo const &pet, LocaleConstant locale) const
+      {
+        if (locale >= TOTAL_LOCALES || !localeNames[locale])
+          return nullptr;
+        auto const &spans = localeNames[locale]->spans;
+        auto it = spans.find(pet.entry);
+        return it != spans.end() ? &it->second : nullptr;
+      }
+
+      uint64 catalogVersion = 0; // beastmaster_tames_version the lists were built from
+      uint32 catalogGeneration = 0; // bumped when anything menus index into changes
+      std::set<uint32> rarePetEntries;
+      std::set<uint32> rareExoticPetEntries;
+
+      size_t PetCount() const { return petSlots ? petSlots->size() : 0; }
+
+      PetList const &CategoryPets(PetCategory c) const
+      {
+        static PetList const empty;
+        auto const &list = pets[size_t(c)];
+        return list ? *list : empty;
+      }
+
+      PetInfo const *FindPet(uint32 entry) const
+      {
+        if (!petSlots)
+          return nullptr;
+        auto it = petSlots->find(entry);
+        if (it == petSlots->end())
+          return nullptr;
+        return &CategoryPets(it->second.category)[it->second.index];
+      }
+    };
+
+    // Current State. A mutex-guarded swap rather than
+    // std::atomic<std::shared_ptr>, which libc++ lacks; the lock only covers
+    // the pointer copy.
+    mutable std::mutex stateMutex;
+    std::shared_ptr<State const> state = std::make_shared<State const>();
+
+    std::shared_ptr<State const> Current() const
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      return state;
+    }
+
+    // Returns the replaced State so it is released outside the lock.
+    std::shared_ptr<State const> Publish(std::shared_ptr<State const> next)
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      state.swap(next);
+      return next;
+    }
+
+    // Bumped on every published load so per-player eligibility caches built
+    // against older rules recompute on next use.
+    std::atomic<uint32> configGeneration{1};
+
+    // Mirrors State::config.keepPetHappy for the per-tick PlayerUpdate check.
+    std::atomic<bool> keepPetHappy{false};
+
+    // Catalog change poll, driven from the world update. The version marker
+    // is read through the async DB queue; only a changed version wakes the
+    // loader. The timer, processor and pending flag belong to the world thread.
+    std::atomic<uint32> catalogPollMs{0};
+    uint32 catalogPollTimer = 0;
+    QueryCallbackProcessor catalogPollQueries;
+    bool catalogPollPending = false;
+
+    // Background loader; at most one load runs at a time. `ready` flips once
+    // the first State has been published and never goes back. `loadFailed`
+    // records that the initial load could not read the pet table, so gossip
+    // reports it instead of retrying; a successful reload clears it.
+    std::mutex loaderMutex;
+    std::thread loader;
+    std::atomic<bool> loading{false};
+    std::atomic<bool> ready{false};
+    std::atomic<bool> loadFailed{false};
+
+    // Messages produced off the map threads (e.g. reload results), keyed by
+    // player guid and delivered from PlayerUpdate. Undelivered ones expire so
+    // a logged out recipient does not keep the flag raised.
+    struct PendingNotices
+    {
+      time_t expires = 0;
+      std::vector<std::string> lines;
+    };
+    std::unordered_map<uint64, PendingNotices> notices;
+    std::mutex noticesMutex;
+    std::atomic<bool> hasNotices{false};
 
     // Caches
     std::unordered_map<uint64, std::set<uint32>> tamedEntriesCache;
     std::mutex tamedEntriesMutex;
-    std::unordered_map<uint64, std::vector<std::tuple<uint32, std::string, std::string>>> trackedPetsCache;
+    std::unordered_map<uint64, TrackedPetList> trackedPetsCache;
     std::mutex trackedPetsCacheMutex;
 
     // Hunter spell list for granting/removing abilities
@@ -115,40 +881,26 @@ namespace
     static constexpr uint32 PET_MAX_HAPPINESS = 1048000;
 
     // Gossip / action ranges
+    // Gossip menu ids and paging (action words come from GossipAction)
     struct Gossip
     {
       static constexpr uint32 PageSize = 13; // pets per page (main pet browsing)
-      static constexpr uint32 PetsStart = 501;
-      static constexpr uint32 ExoticStart = 601;
-      static constexpr uint32 RareStart = 701;
-      static constexpr uint32 RareExoticStart = 801;
-      static constexpr uint32 PetEntryOffset = 901; // actions >= this encode pet entry adoption
-      static constexpr uint32 MainMenu = 50;
-      static constexpr uint32 RemoveSkills = 80;
+      static constexpr uint32 FamilyPageSize = 20; // families per page
+      static constexpr uint32 LetterMenuMinPages = 4; // offer jumps from here on
       static constexpr uint32 GossipHello = 601026;
       static constexpr uint32 GossipBrowse = 601027;
-      static constexpr uint32 TrackedPetsMenu = 1000; // first page = +1 arithmetic
     };
 
     struct Tracked
     {
-      static constexpr uint32 MenuBase = 1000;   // page arithmetic base
-      static constexpr uint32 SummonBase = 2000; // Summon action range start
-      static constexpr uint32 RenameBase = 3000; // Rename action range start
-      static constexpr uint32 DeleteBase = 4000; // Delete action range start
-      static constexpr uint32 PageSize = 10;     // tracked pets per page
+      static constexpr uint32 PageSize = 9; // tracked pets per page
     };
 
-    // Helpers to interpret action codes
-    static bool IsBrowseNormal(uint32 a) { return a >= Gossip::PetsStart && a < Gossip::ExoticStart; }
-    static bool IsBrowseExotic(uint32 a) { return a >= Gossip::ExoticStart && a < Gossip::RareStart; }
-    static bool IsBrowseRare(uint32 a) { return a >= Gossip::RareStart && a < Gossip::RareExoticStart; }
-    static bool IsBrowseRareExotic(uint32 a) { return a >= Gossip::RareExoticStart && a < Gossip::PetEntryOffset; }
-    static bool IsAdoptAction(uint32 a) { return a >= Gossip::PetEntryOffset; }
-    static bool IsTrackedMenu(uint32 a) { return a >= Gossip::TrackedPetsMenu && a < Tracked::SummonBase; }
-    static bool IsTrackedSummon(uint32 a) { return a >= Tracked::SummonBase && a < Tracked::RenameBase; }
-    static bool IsTrackedRename(uint32 a) { return a >= Tracked::RenameBase && a < Tracked::DeleteBase; }
-    static bool IsTrackedDelete(uint32 a) { return a >= Tracked::DeleteBase && a < Tracked::DeleteBase + 1000; }
+    ~BeastmasterRuntime()
+    {
+      if (loader.joinable())
+        loader.join();
+    }
 
     static BeastmasterRuntime &Instance()
     {
@@ -163,19 +915,6 @@ enum BeastmasterEvents
   BEASTMASTER_EVENT_EAT = 1
 };
 
-enum TrackedPetActions
-{
-  PET_TRACKED_SUMMON = 2000,
-  PET_TRACKED_RENAME = 3000,
-  PET_TRACKED_DELETE = 4000,
-  PET_TRACKED_PAGE_SIZE = 10
-};
-
-enum
-{
-  PET_TRACKED_RENAME_PROMPT = 5000
-};
-
 static std::unordered_set<std::string> sProfanityList;
 static time_t sProfanityListMTime = 0;
 
@@ -189,46 +928,36 @@ static time_t GetFileMTime(std::string_view path)
   return 0;
 }
 
-static std::set<uint8> ParseAllowedRaces(std::string_view csv)
+// Calls fn(value) for every unsigned integer in a comma separated list.
+// Malformed items are skipped.
+template <typename Fn>
+static void ForEachCsvNumber(std::string_view csv, Fn &&fn)
 {
-  std::set<uint8> result;
-  std::string csvStr(csv.data(), csv.size());
-  std::stringstream ss(csvStr);
-  std::string item;
-  while (std::getline(ss, item, ','))
+  while (!csv.empty())
   {
-    try
-    {
-      uint8 race = static_cast<uint8>(std::stoul(item));
-      if (race > 0)
-        result.insert(race);
-    }
-    catch (...)
-    {
-    }
+    size_t comma = csv.find(',');
+    std::string_view item = csv.substr(0, comma);
+    while (!item.empty() && std::isspace(uint8(item.front())))
+      item.remove_prefix(1);
+    uint32 value = 0;
+    auto [ptr, ec] = std::from_chars(item.data(), item.data() + item.size(), value);
+    if (ec == std::errc() && ptr != item.data())
+      fn(value);
+    if (comma == std::string_view::npos)
+      break;
+    csv.remove_prefix(comma + 1);
   }
-  return result;
 }
 
-static std::set<uint8> ParseAllowedClasses(std::string_view csv)
+// Parses a class or race id list into a bitmask (0 = no restriction).
+static uint32 ParseIdMask(std::string_view csv)
 {
-  std::set<uint8> result;
-  std::string csvStr(csv.data(), csv.size());
-  std::stringstream ss(csvStr);
-  std::string item;
-  while (std::getline(ss, item, ','))
-  {
-    try
-    {
-      uint8 cls = static_cast<uint8>(std::stoul(item));
-      if (cls > 0)
-        result.insert(cls);
-    }
-    catch (...)
-    {
-    }
-  }
-  return result;
+  uint32 mask = 0;
+  ForEachCsvNumber(csv, [&mask](uint32 id)
+                   {
+    if (id > 0 && id < 32)
+      mask |= 1u << id; });
+  return mask;
 }
 
 static void LoadProfanityListIfNeeded()
@@ -285,269 +1014,1905 @@ static bool IsValidPetName(std::string_view name)
 static std::set<uint32> ParseEntryList(std::string_view csv)
 {
   std::set<uint32> result;
-  std::string csvStr(csv.data(), csv.size());
-  std::stringstream ss(csvStr);
-  std::string item;
-  while (std::getline(ss, item, ','))
-  {
-    try
-    {
-      result.insert(std::stoul(item));
-    }
-    catch (...)
-    {
-    }
-  }
+  ForEachCsvNumber(csv, [&result](uint32 entry)
+                   { result.insert(entry); });
   return result;
 }
 
-static const PetInfo *FindPetInfo(uint32 entry)
+// --- Tracked pets cache mutation ----------------------------------------
+// The cache mirrors "ORDER BY date_tamed DESC" and is patched in place so the
+// tracked menu never has to requery after its initial load. All helpers are
+// no-ops until the player's list has been loaded once.
+// Copied out so the result stays valid if a reload swaps the catalog.
+static std::string DefaultPetName(uint32 entry)
 {
-  auto &rt = BeastmasterRuntime::Instance();
-  std::lock_guard<std::mutex> lock(rt.petsMutex);
-  auto it = rt.allPetsByEntry.find(entry);
-  return it != rt.allPetsByEntry.end() ? &it->second : nullptr;
+  auto state = BeastmasterRuntime::Instance().Current();
+  const PetInfo *info = state->FindPet(entry);
+  return info ? info->name : std::string();
 }
 
-class BeastmasterBool : public DataMap::Base
+// Only called while rendering a page; records keep the raw epoch.
+static std::string FormatTamedDate(uint32 tamedAt)
 {
-public:
-  explicit BeastmasterBool(bool v) : value(v) {}
-  bool value;
-};
+  char buf[11];
+  time_t t = time_t(tamedAt);
+  std::tm tmv{};
+#ifdef _WIN32
+  localtime_s(&tmv, &t);
+#else
+  localtime_r(&t, &tmv);
+#endif
+  std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tmv);
+  return buf;
+}
 
-class BeastmasterUInt32 : public DataMap::Base
+// Columns: entry, name, UNIX_TIMESTAMP(date_tamed), last_summoned.
+static TrackedPetRecord ReadTrackedPetRow(Field *fields)
 {
-public:
-  explicit BeastmasterUInt32(uint32 v) : value(v) {}
-  uint32 value;
-};
+  uint32 entry = fields[0].Get<uint32>();
+  TrackedPetRecord rec(entry, fields[2].Get<uint32>(),
+                       fields[1].Get<std::string>(), DefaultPetName(entry));
+  rec.summonedAt = fields[3].Get<uint32>();
+  return rec;
+}
 
-class BeastmasterPetMap : public DataMap::Base
+// Case-folded, accent-stripped form of a UTF-8 name; byte order of keys is
+// the display order of names. Latin-1 letters fold to their base letters
+// ("Élan" -> "elan", "ß" -> "ss"); other scripts are kept byte for byte.
+static std::string CollationKey(std::string_view text)
 {
-public:
-  std::map<uint32, uint32> map;
-  BeastmasterPetMap(const std::map<uint32, uint32> &m) : map(m) {}
+  static constexpr char const *Latin1[64] = {
+      "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+      "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "ss",
+      "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+      "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "y"};
+
+  std::string key;
+  key.reserve(text.size());
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    unsigned char c = text[i];
+    if (c < 0x80)
+      key.push_back(char(std::tolower(c)));
+    else if (c == 0xC3 && i + 1 < text.size() &&
+             (uint8(text[i + 1]) & 0xC0) == 0x80 && Latin1[uint8(text[i + 1]) - 0x80])
+      key += Latin1[uint8(text[++i]) - 0x80];
+    else
+      key.push_back(char(c));
+  }
+  return key;
+}
+
+static TrackedSortFields TrackedSortFieldsFor(TrackedPetRecord const &rec)
+{
+  auto state = BeastmasterRuntime::Instance().Current();
+  TrackedSortFields fields;
+  PetInfo const *info = state->FindPet(rec.entry);
+  fields.nameKey = CollationKey(rec.HasCustomName() ? rec.CustomName()
+                                : info           ? std::string_view(info->name)
+                                                 : std::string_view());
+  if (!info)
+  {
+    fields.rarityRank = uint8(PetCategory::Count);
+    return fields;
+  }
+  fields.family = info->family;
+  static constexpr uint8 RarityRank[] = {3, 2, 1, 0}; // indexed by PetCategory
+  fields.rarityRank = RarityRank[size_t(state->petSlots->at(rec.entry).category)];
+  return fields;
+}
+
+static void TrackedCacheInsert(uint64 guid, TrackedPetRecord const &rec)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  TrackedSortFields fields = TrackedSortFieldsFor(rec);
+  std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+  auto it = rt.trackedPetsCache.find(guid);
+  if (it == rt.trackedPetsCache.end())
+    return;
+  it->second.Insert(rec, std::move(fields));
+}
+
+static void TrackedCacheRename(uint64 guid, uint32 entry,
+                               std::string const &name)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+  auto it = rt.trackedPetsCache.find(guid);
+  if (it == rt.trackedPetsCache.end())
+    return;
+  it->second.Update(entry, [&](TrackedPetRecord &rec, TrackedSortFields &fields)
+                    {
+                      rec.SetName(name);
+                      fields = TrackedSortFieldsFor(rec);
+                    });
+}
+
+// Copies the stored state for a tracked pet out of the cache. Returns false if
+// the list is not cached or the entry is not tracked.
+static bool TrackedCacheLookup(uint64 guid, uint32 entry, TrackedPetRecord &out)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+  auto it = rt.trackedPetsCache.find(guid);
+  if (it == rt.trackedPetsCache.end())
+    return false;
+  if (TrackedPetRecord const *r = it->second.Find(entry))
+  {
+    out = *r;
+    return true;
+  }
+  return false;
+}
+
+// Returns the remaining number of tracked pets, or -1 if the list is not cached.
+static int32 TrackedCacheErase(uint64 guid, uint32 entry)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+  auto it = rt.trackedPetsCache.find(guid);
+  if (it == rt.trackedPetsCache.end())
+    return -1;
+  it->second.Erase(entry);
+  return int32(it->second.size());
+}
+
+// Records a summon for the Recent order. The time is written back lazily by
+// FlushTrackedRecency; without a cached list (keyset paging) it is written
+// straight away.
+static void TrackedCacheTouch(uint64 guid, uint32 ownerCounter, uint32 entry)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  uint32 now = uint32(time(nullptr));
+  {
+    std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+    auto it = rt.trackedPetsCache.find(guid);
+    if (it != rt.trackedPetsCache.end() && it->second.Touch(entry, now))
+      return;
+  }
+  CharacterDatabase.Execute("UPDATE beastmaster_tamed_pets SET last_summoned = {} "
+                            "WHERE owner_guid = {} AND entry = {}",
+                            now, ownerCounter, entry);
+}
+
+// Writes pending summon times in one statement.
+static void FlushTrackedRecency(uint32 ownerCounter,
+                                std::vector<std::pair<uint32, uint32>> const &times)
+{
+  if (times.empty())
+    return;
+  std::string cases, entries;
+  for (auto const &[entry, summonedAt] : times)
+  {
+    cases += Acore::StringFormat(" WHEN {} THEN {}", entry, summonedAt);
+    entries += Acore::StringFormat("{}{}", entries.empty() ? "" : ",", entry);
+  }
+  CharacterDatabase.Execute("UPDATE beastmaster_tamed_pets SET last_summoned = "
+                            "CASE entry{} END WHERE owner_guid = {} AND entry IN ({})",
+                            cases, ownerCounter, entries);
+}
+
+class BeastmasterBool : public DataMap::Base
+{
+public:
+  explicit BeastmasterBool(bool v) : value(v) {}
+  bool value;
+};
+
+class BeastmasterUInt32 : public DataMap::Base
+{
+public:
+  explicit BeastmasterUInt32(uint32 v) : value(v) {}
+  uint32 value;
+};
+
+// Order the player last chose for the tracked pets menu (session only).
+// Defaults to Recent so the pets a player actually uses come first.
+static TrackedSort GetTrackedSort(Player *player)
+{
+  auto *sort = player->CustomData.Get<BeastmasterUInt32>("BeastmasterTrackedSort");
+  return sort && sort->value < uint32(TrackedSort::Count) ? TrackedSort(sort->value)
+                                                           : TrackedSort::Recent;
+}
+
+// Per-player eligibility bits, refreshed lazily after a PlayerScript hook (level,
+// talent, spec or relevant spell change) or a config reload invalidates them.
+enum BeastmasterEligibilityFlags : uint8
+{
+  ELIGIBLE_ALLOWED = 0x01,        // class/race/level gate passed
+  ELIGIBLE_EXOTIC = 0x02,         // may browse exotic categories
+  ELIGIBLE_NEEDS_BM_TEACH = 0x04, // exotic browse should teach Beast Mastery
+  ELIGIBLE_CAN_UNLEARN = 0x08,    // non-hunter with Call Pet
+  ELIGIBLE_BM_TALENT = 0x10,      // Beast Mastery talent in active spec
+  ELIGIBLE_HUNTER = 0x20
+};
+
+// Folds the eligibility bits that shape the main menu into a variant index.
+static constexpr uint8 MainMenuSignature(uint8 eligible)
+{
+  return ((eligible & ELIGIBLE_HUNTER) ? 1 : 0) |
+         ((eligible & ELIGIBLE_EXOTIC) ? 2 : 0) |
+         ((eligible & ELIGIBLE_CAN_UNLEARN) ? 4 : 0);
+}
+
+class BeastmasterEligibility : public DataMap::Base
+{
+public:
+  uint32 generation = 0; // 0 = stale
+  uint8 flags = 0;
+};
+
+// Keyset pagination state for one player's tracked pets view. Only the current
+// window (requested page plus prefetch) is held in memory; pages are addressed
+// by the (date_tamed, entry) key of the last row before them. Bounds are kept
+// for the window's pages and the one after it only, so memory does not grow
+// with how far the player pages; other pages are reached with an OFFSET seek.
+class BeastmasterTrackedWindow : public DataMap::Base
+{
+public:
+  struct Cursor
+  {
+    uint32 tamedAt;
+    uint32 entry;
+  };
+
+  std::vector<TrackedPetRecord> rows;
+  uint32 firstPage = 0;         // page of rows[0]; 0 = nothing loaded
+  bool more = false;            // rows exist past the end of the window
+  std::optional<Cursor> before; // bound of firstPage, when it was known
+  std::vector<Cursor> cursors;  // cursors[i] = exclusive bound for page cursorPage + i
+  uint32 cursorPage = 0;
+  uint32 lastPage = 1;          // furthest page known to exist
+
+  // Bound for `page`, if the window knows it.
+  std::optional<Cursor> CursorFor(uint32 page) const
+  {
+    if (page < cursorPage || page - cursorPage >= cursors.size())
+      return std::nullopt;
+    return cursors[page - cursorPage];
+  }
+
+  // Rebuilds page bounds covered by the window after rows changed.
+  void RecomputeCursors(uint32 pageSize)
+  {
+    if (!firstPage)
+      return;
+    cursors.clear();
+    cursorPage = before ? firstPage : firstPage + 1;
+    if (before)
+      cursors.push_back(*before);
+    for (size_t end = pageSize; end <= rows.size(); end += pageSize)
+      cursors.push_back({rows[end - 1].tamedAt, rows[end - 1].entry});
+    uint32 pages = uint32((rows.size() + (more ? 1 : 0) + pageSize - 1) / pageSize);
+    lastPage = std::max(lastPage, firstPage + std::max<uint32>(pages, 1) - 1);
+  }
+};
+
+static BeastmasterTrackedWindow *GetTrackedWindow(Player *player)
+{
+  return player->CustomData.Get<BeastmasterTrackedWindow>(
+      "BeastmasterTrackedWindow");
+}
+
+static void ResetTrackedWindow(Player *player)
+{
+  player->CustomData.Erase("BeastmasterTrackedWindow");
+}
+
+// Fetches up to `limit` tracked pets older than `after` (newest first) using
+// the (owner_guid, date_tamed, entry) index. Without a bound, skips `offset`
+// rows instead.
+static std::vector<TrackedPetRecord> FetchTrackedPetsAfter(
+    Player *player, BeastmasterTrackedWindow::Cursor const *after, uint32 limit,
+    uint32 offset = 0)
+{
+  std::vector<TrackedPetRecord> out;
+  QueryResult result;
+  if (after)
+    result = CharacterDatabase.Query(
+        "SELECT entry, name, UNIX_TIMESTAMP(date_tamed), last_summoned FROM "
+        "beastmaster_tamed_pets WHERE owner_guid = {} AND (date_tamed < "
+        "FROM_UNIXTIME({}) OR (date_tamed = FROM_UNIXTIME({}) AND entry < {})) "
+        "ORDER BY date_tamed DESC, entry DESC LIMIT {}",
+        player->GetGUID().GetCounter(), after->tamedAt, after->tamedAt,
+        after->entry, limit);
+  else
+    result = CharacterDatabase.Query(
+        "SELECT entry, name, UNIX_TIMESTAMP(date_tamed), last_summoned FROM "
+        "beastmaster_tamed_pets WHERE owner_guid = {} "
+        "ORDER BY date_tamed DESC, entry DESC LIMIT {} OFFSET {}",
+        player->GetGUID().GetCounter(), limit, offset);
+  if (!result)
+    return out;
+  out.reserve(result->GetRowCount());
+  do
+  {
+    out.push_back(ReadTrackedPetRow(result->Fetch()));
+  } while (result->NextRow());
+  return out;
+}
+
+// Serves one page of the keyset view, refilling the window only when the page
+// lies outside it. Pages past the furthest known one clamp to it.
+static bool LoadTrackedPageKeyset(Player *player, uint32 &page,
+                                  std::vector<TrackedPetRecord> &pageRows)
+{
+  uint32 const pageSize = BeastmasterRuntime::Tracked::PageSize;
+  auto *win = player->CustomData.GetDefault<BeastmasterTrackedWindow>(
+      "BeastmasterTrackedWindow");
+
+  page = std::clamp<uint32>(page, 1, win->lastPage);
+
+  auto inWindow = [&]()
+  {
+    if (!win->firstPage || page < win->firstPage)
+      return false;
+    size_t begin = size_t(page - win->firstPage) * pageSize;
+    if (begin > 0 && begin >= win->rows.size())
+      return false;
+    return begin + pageSize <= win->rows.size() || !win->more;
+  };
+
+  if (!inWindow())
+  {
+    uint32 capacity =
+        pageSize *
+        (1 + BeastmasterRuntime::Instance().Current()->config.trackedPrefetchPages);
+    win->before = page > 1 ? win->CursorFor(page) : std::nullopt;
+    win->rows = FetchTrackedPetsAfter(player, win->before ? &*win->before : nullptr,
+                                      capacity + 1, win->before ? 0 : (page - 1) * pageSize);
+    win->more = win->rows.size() > capacity;
+    if (win->more)
+      win->rows.pop_back();
+    win->firstPage = page;
+    win->RecomputeCursors(pageSize);
+  }
+
+  size_t begin = size_t(page - win->firstPage) * pageSize;
+  size_t end = std::min(begin + pageSize, win->rows.size());
+  pageRows.assign(win->rows.begin() + begin, win->rows.begin() + end);
+  return end < win->rows.size() || (end == win->rows.size() && win->more &&
+                                    end - begin == pageSize);
+}
+
+// Keyset mode keeps no full list; the rows the menu was built from live in the
+// player's window instead.
+static bool TrackedLookup(Player *player, uint32 entry, TrackedPetRecord &out)
+{
+  if (TrackedCacheLookup(player->GetGUID().GetRawValue(), entry, out))
+    return true;
+  if (auto *win = GetTrackedWindow(player))
+    for (auto const &r : win->rows)
+      if (r.entry == entry)
+      {
+        out = r;
+        return true;
+      }
+  return false;
+}
+
+static uint8 ComputeEligibility(Player *player)
+{
+  auto state = BeastmasterRuntime::Instance().Current();
+  bool hunter = player->getClass() == CLASS_HUNTER;
+  bool bmSpell = player->HasSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY);
+  bool bmTalent = player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY,
+                                    player->GetActiveSpec());
+
+  uint8 flags = 0;
+  if (state->eligibility.Allows(player->getClass(), player->getRace(),
+                                player->GetLevel()))
+    flags |= ELIGIBLE_ALLOWED;
+  if ((state->config.allowExotic || bmSpell || bmTalent) &&
+      (!hunter || !state->config.hunterBeastMasteryRequired || bmTalent))
+    flags |= ELIGIBLE_EXOTIC;
+  if (!bmSpell && !bmTalent)
+    flags |= ELIGIBLE_NEEDS_BM_TEACH;
+  if (!hunter && player->HasSpell(BeastmasterRuntime::PET_SPELL_CALL_PET))
+    flags |= ELIGIBLE_CAN_UNLEARN;
+  if (bmTalent)
+    flags |= ELIGIBLE_BM_TALENT;
+  if (hunter)
+    flags |= ELIGIBLE_HUNTER;
+  return flags;
+}
+
+static uint8 GetEligibility(Player *player)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  uint32 generation = rt.configGeneration.load(std::memory_order_acquire);
+  auto *cache = player->CustomData.GetDefault<BeastmasterEligibility>(
+      "BeastmasterEligibility");
+  if (cache->generation != generation)
+  {
+    cache->flags = ComputeEligibility(player);
+    cache->generation = generation;
+  }
+  return cache->flags;
+}
+
+static MainMenuVariants BuildMainMenuVariants(bool trackTamedPets)
+{
+  MainMenuVariants variants;
+  for (uint8 sig = 0; sig < MainMenuVariantCount; ++sig)
+  {
+    bool hunter = sig & 1;
+    bool exotic = sig & 2;
+    bool canUnlearn = sig & 4;
+    auto &items = variants[sig];
+
+    items.push_back({GOSSIP_ICON_BATTLE, "Browse Pets",
+                     GossipAction::Browse(PetCategory::Normal, 1)});
+    items.push_back({GOSSIP_ICON_BATTLE, "Browse Rare Pets",
+                     GossipAction::Browse(PetCategory::Rare, 1)});
+    if (exotic)
+    {
+      items.push_back({GOSSIP_ICON_BATTLE, "Browse Exotic Pets",
+                       GossipAction::Browse(PetCategory::Exotic, 1)});
+      items.push_back({GOSSIP_ICON_BATTLE, "Browse Rare Exotic Pets",
+                       GossipAction::Browse(PetCategory::RareExotic, 1)});
+    }
+    items.push_back({GOSSIP_ICON_BATTLE, "Browse by Family",
+                     GossipAction::FamilyList(1)});
+    items.push_back({GOSSIP_ICON_BATTLE, "Pets in This Zone",
+                     GossipAction::NearbyPage(1)});
+    items.push_back({GOSSIP_ICON_BATTLE, "Search Pets",
+                     GossipAction::SearchPage(1), true});
+    if (canUnlearn)
+      items.push_back({GOSSIP_ICON_BATTLE, "Unlearn Hunter Abilities",
+                       GossipAction::Simple(ActionOp::RemoveSkills)});
+    if (trackTamedPets)
+      items.push_back({GOSSIP_ICON_CHAT, "My Tamed Pets",
+                       GossipAction::TrackedPage(1)});
+    if (hunter)
+      items.push_back({GOSSIP_ICON_TAXI, "Visit Stable", GOSSIP_OPTION_STABLEPET});
+    items.push_back({GOSSIP_ICON_MONEY_BAG, "Buy Pet Food", GOSSIP_OPTION_VENDOR});
+  }
+  return variants;
+}
+
+// 1-based page the entry currently sits on in the tracked view (1 if unknown).
+static uint32 TrackedPageOf(Player *player, uint32 entry)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  uint32 const pageSize = BeastmasterRuntime::Tracked::PageSize;
+  {
+    std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+    auto it = rt.trackedPetsCache.find(player->GetGUID().GetRawValue());
+    if (it != rt.trackedPetsCache.end())
+      if (int32 pos = it->second.PositionOf(GetTrackedSort(player), entry); pos >= 0)
+        return uint32(pos) / pageSize + 1;
+  }
+  if (auto *win = GetTrackedWindow(player))
+    for (size_t i = 0; i < win->rows.size(); ++i)
+      if (win->rows[i].entry == entry)
+        return win->firstPage + uint32(i / pageSize);
+  return 1;
+}
+
+// --- Pet catalog -----------------------------------------------------------
+static PetCategory ClassifyPet(BeastmasterRuntime::State const &state, PetInfo const &info)
+{
+  if (state.rarePetEntries.count(info.entry))
+    return PetCategory::Rare;
+  if (state.rareExoticPetEntries.count(info.entry))
+    return PetCategory::RareExotic;
+  if (info.rarity == "exotic")
+    return PetCategory::Exotic;
+  return PetCategory::Normal;
+}
+
+static uint32 PetIconForFamily(uint32 family)
+{
+  static const std::set<uint32> TrainerIconFamilies = {
+      1, 2, 3, 4, 7, 8, 9, 10, 15, 20, 21, 30, 24, 31, 25, 34, 27};
+  return TrainerIconFamilies.count(family) ? GOSSIP_ICON_TRAINER
+                                           : GOSSIP_ICON_VENDOR;
+}
+
+using CatalogRows = std::vector<std::pair<PetInfo, PetCategory>>;
+
+// Collation key reduced to letters and digits, so "Loque'nahak",
+// "loquenahak" and "Loqué nahak" meet.
+static std::string NormalizeSearchKey(std::string_view text)
+{
+  std::string key;
+  for (unsigned char c : CollationKey(text))
+    if (c >= 0x80 || std::isalnum(c))
+      key.push_back(char(c));
+  return key;
+}
+
+// Calls fn once per distinct trigram of key, padded so word edges count.
+template <typename Fn>
+static void ForEachTrigram(std::string_view key, Fn &&fn)
+{
+  std::string padded = "  " + std::string(key) + " ";
+  std::vector<uint32> grams;
+  grams.reserve(padded.size());
+  for (size_t i = 0; i + 3 <= padded.size(); ++i)
+    grams.push_back(uint32(uint8(padded[i])) << 16 |
+                    uint32(uint8(padded[i + 1])) << 8 | uint8(padded[i + 2]));
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  for (uint32 g : grams)
+    fn(g);
+}
+
+
+// Levenshtein distance, or bound + 1 as soon as it is known to exceed bound.
+static uint32 BoundedEditDistance(std::string_view a, std::string_view b,
+                                  uint32 bound)
+{
+  if (a.size() > b.size())
+    std::swap(a, b);
+  if (b.size() - a.size() > bound)
+    return bound + 1;
+
+  std::vector<uint32> row(a.size() + 1);
+  for (uint32 i = 0; i < row.size(); ++i)
+    row[i] = i;
+  for (size_t j = 1; j <= b.size(); ++j)
+  {
+    uint32 diag = row[0];
+    row[0] = uint32(j);
+    uint32 best = row[0];
+    for (size_t i = 1; i <= a.size(); ++i)
+    {
+      uint32 up = row[i];
+      row[i] = std::min({row[i] + 1, row[i - 1] + 1,
+                         diag + (a[i - 1] != b[j - 1] ? 1u : 0u)});
+      diag = up;
+      best = std::min(best, row[i]);
+    }
+    if (best > bound)
+      return bound + 1;
+  }
+  return std::min(row[a.size()], bound + 1);
+}
+
+static std::shared_ptr<std::vector<BeastmasterRuntime::State::FamilyBucket> const>
+BuildFamilyBuckets(BeastmasterRuntime::State const &state)
+{
+  std::map<uint32, BeastmasterRuntime::State::FamilyBucket> byFamily;
+  for (size_t c = 0; c < state.pets.size(); ++c)
+  {
+    PetList const &list = state.CategoryPets(PetCategory(c));
+    for (uint32 i = 0; i < list.size(); ++i)
+    {
+      auto &bucket = byFamily[list[i].family];
+      bucket.family = list[i].family;
+      bucket.pets[c].push_back(i);
+    }
+  }
+  auto buckets = std::make_shared<std::vector<BeastmasterRuntime::State::FamilyBucket>>();
+  buckets->reserve(byFamily.size());
+  for (auto &[family, bucket] : byFamily)
+    buckets->push_back(std::move(bucket));
+  return buckets;
+}
+
+// Initial a sort key is filed under: an upper-cased ASCII letter, '#' for
+// other ASCII, or the whole first UTF-8 character (keys fold Latin-1, so
+// this is only reached for other scripts).
+static std::string InitialOf(std::string_view key)
+{
+  unsigned char c = key.empty() ? 0 : key.front();
+  if (c < 0x80)
+    return std::isalpha(c) ? std::string(1, char(std::toupper(c))) : "#";
+  size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+  return std::string(key.substr(0, length));
+}
+
+// Sorts a category list by the names `locale` shows and indexes the result
+// by level bracket and initial.
+static std::shared_ptr<BeastmasterRuntime::State::CategoryOrder const>
+BuildCategoryOrder(BeastmasterRuntime::State const &state, PetList const &list,
+                   LocaleConstant locale)
+{
+  using State = BeastmasterRuntime::State;
+  auto order = std::make_shared<State::CategoryOrder>();
+  uint32 count = uint32(list.size());
+  if (locale != LOCALE_enUS && state.localeNames[locale])
+  {
+    order->order.resize(count);
+    std::iota(order->order.begin(), order->order.end(), 0);
+    std::sort(order->order.begin(), order->order.end(), [&](uint32 a, uint32 b)
+              { return std::pair{state.PetSortKey(list[a], locale), list[a].entry} <
+                       std::pair{state.PetSortKey(list[b], locale), list[b].entry}; });
+    order->rank.resize(count);
+    for (uint32 p = 0; p < count; ++p)
+      order->rank[order->order[p]] = p;
+  }
+
+  for (uint32 b = 0; b < State::LevelBrackets; ++b)
+  {
+    uint32 top = b + 1 < State::LevelBrackets ? (b + 1) * State::LevelBracketSize
+                                              : UINT32_MAX;
+    for (uint32 p = 0; p < count; ++p)
+      if (list[order->IndexAt(p)].minLevel <= top)
+        order->levels[b].push_back(p);
+  }
+
+  for (uint32 p = 0; p < count; ++p)
+  {
+    std::string letter = InitialOf(state.PetSortKey(list[order->IndexAt(p)], locale));
+    if (order->letters.empty() || order->letters.back().letter != letter)
+      order->letters.push_back({std::move(letter), p});
+  }
+  return order;
+}
+
+// Builds every locale's display order of every category, reusing the
+// previous State's where neither the list nor the locale's names changed.
+// Locales without names share the enUS order.
+static void BuildDisplayOrders(BeastmasterRuntime::State &state,
+                               BeastmasterRuntime::State const &previous)
+{
+  for (size_t l = 0; l < TOTAL_LOCALES; ++l) // enUS (0) first
+  {
+    LocaleConstant locale = LocaleConstant(l);
+    if (locale != LOCALE_enUS && !state.localeNames[l])
+    {
+      state.orders[l] = state.orders[LOCALE_enUS];
+      continue;
+    }
+    bool sameNames = locale == LOCALE_enUS ||
+                     (previous.localeNames[l] && *previous.localeNames[l] == *state.localeNames[l]);
+    for (size_t c = 0; c < state.pets.size(); ++c)
+    {
+      if (sameNames && state.pets[c] == previous.pets[c] && previous.orders[l][c])
+        state.orders[l][c] = previous.orders[l][c];
+      else
+        state.orders[l][c] = BuildCategoryOrder(state, state.CategoryPets(PetCategory(c)), locale);
+    }
+  }
+}
+
+// Adds a key for every word start of name; words start at letters, digits
+// and non-ASCII characters after a space or hyphen.
+static void AddSearchKeys(std::vector<BeastmasterRuntime::State::SearchKey> &keys,
+                          std::string_view name, BeastmasterRuntime::State::PetSlot slot)
+{
+  for (size_t i = 0; i < name.size(); ++i)
+  {
+    unsigned char c = name[i];
+    if ((std::isalnum(c) || c >= 0xC0) &&
+        (i == 0 || name[i - 1] == ' ' || name[i - 1] == '-'))
+      keys.push_back({NormalizeSearchKey(name.substr(i)), slot});
+  }
+}
+
+static std::shared_ptr<BeastmasterRuntime::State::SearchIndex const>
+BuildSearchIndex(BeastmasterRuntime::State const &state, LocaleConstant locale)
+{
+  auto index = std::make_shared<BeastmasterRuntime::State::SearchIndex>();
+  for (auto const &[entry, slot] : *state.petSlots)
+  {
+    PetInfo const &pet = state.CategoryPets(slot.category)[slot.index];
+    AddSearchKeys(index->keys, pet.name, slot);
+    if (state.LocalizedSpan(pet, locale))
+      AddSearchKeys(index->keys, state.PetName(pet, locale), slot);
+  }
+  std::sort(index->keys.begin(), index->keys.end(),
+            [](auto const &a, auto const &b) { return a.key < b.key; });
+  for (uint32 doc = 0; doc < index->keys.size(); ++doc)
+    ForEachTrigram(index->keys[doc].key, [&](uint32 g) { index->trigrams[g].push_back(doc); });
+  return index;
+}
+
+// Builds every locale's search index, reusing the previous State's where
+// neither the catalog nor the locale's names changed. Locales without names
+// share the enUS index.
+static void BuildSearchIndexes(BeastmasterRuntime::State &state,
+                               BeastmasterRuntime::State const &previous)
+{
+  for (size_t l = 0; l < TOTAL_LOCALES; ++l) // enUS (0) first
+  {
+    LocaleConstant locale = LocaleConstant(l);
+    if (locale != LOCALE_enUS && !state.localeNames[l])
+      state.search[l] = state.search[LOCALE_enUS];
+    else if (state.petSlots == previous.petSlots && previous.search[l] &&
+             (locale == LOCALE_enUS ||
+              (previous.localeNames[l] && *previous.localeNames[l] == *state.localeNames[l])))
+      state.search[l] = previous.search[l];
+    else
+      state.search[l] = BuildSearchIndex(state, locale);
+  }
+}
+
+// Menus encode positions in the lists, orders (and their level views),
+// spawns and search indexes, so a State that changed any of them gets a new
+// generation. Open menus built from an older one are then refused instead of
+// landing on shifted pets.
+static void StampCatalogGeneration(BeastmasterRuntime::State &state,
+                                   BeastmasterRuntime::State const &previous)
+{
+  bool same = state.petSlots == previous.petSlots && state.orders == previous.orders &&
+              state.config.levelFilter == previous.config.levelFilter &&
+              state.spawns == previous.spawns && state.search == previous.search;
+  state.catalogGeneration = previous.catalogGeneration + (same ? 0 : 1);
+}
+
+// Groups rows by category and sorts each by name, reusing the previous
+// State's list for every category that came out identical. Returns how many
+// lists were rebuilt.
+static uint32 AssembleCatalog(BeastmasterRuntime::State &state,
+                              BeastmasterRuntime::State const &previous,
+                              CatalogRows const &rows)
+{
+  std::array<PetList, size_t(PetCategory::Count)> lists;
+  for (auto const &[info, category] : rows)
+  {
+    lists[size_t(category)].push_back(info);
+    lists[size_t(category)].back().sortKey = CollationKey(info.name);
+  }
+  for (auto &list : lists)
+    NpcBeastmaster::SortPetsByName(list);
+
+  uint32 rebuilt = 0;
+  for (size_t c = 0; c < lists.size(); ++c)
+  {
+    auto const &old = previous.pets[c];
+    if (old && *old == lists[c])
+      state.pets[c] = old;
+    else
+    {
+      state.pets[c] = std::make_shared<PetList const>(std::move(lists[c]));
+      ++rebuilt;
+    }
+  }
+
+  if (!rebuilt && previous.petSlots)
+  {
+    state.petSlots = previous.petSlots;
+    state.families = previous.families;
+    return 0;
+  }
+
+  auto slots = std::make_shared<BeastmasterRuntime::State::PetSlots>();
+  slots->reserve(rows.size());
+  for (size_t c = 0; c < state.pets.size(); ++c)
+  {
+    PetList const &list = *state.pets[c];
+    for (uint32 i = 0; i < list.size(); ++i)
+      (*slots)[list[i].entry] = {PetCategory(c), i};
+  }
+  state.petSlots = std::move(slots);
+  state.families = BuildFamilyBuckets(state);
+  return rebuilt;
+}
+
+// --- Pet search ------------------------------------------------------------
+// Exotic categories are only offered to players with exotic access.
+static bool CategoryVisible(PetCategory c, bool exotic)
+{
+  return exotic || (c != PetCategory::Exotic && c != PetCategory::RareExotic);
+}
+
+// Last query typed into the search box, kept for paging through results.
+class BeastmasterSearch : public DataMap::Base
+{
+public:
+  explicit BeastmasterSearch(std::string q) : query(std::move(q)) {}
+  std::string query; // normalized
+  bool submitted = true; // until its first page is shown
 };
 
+// Pets with a name word starting with `query`, each once, skipping exotic
+// categories unless the player may browse them. O(log n + k).
+static std::vector<PetInfo const *> SearchPetsByPrefix(
+    BeastmasterRuntime::State const &state, LocaleConstant locale,
+    std::string const &query, bool exotic)
+{
+  std::vector<PetInfo const *> out;
+  auto const *search = state.Search(locale);
+  if (query.empty() || !search)
+    return out;
+
+  auto const &index = search->keys;
+  auto it = std::lower_bound(index.begin(), index.end(), query,
+                             [](auto const &k, std::string const &q)
+                             { return k.key < q; });
+  std::unordered_set<uint32> seen;
+  for (; it != index.end() && it->key.compare(0, query.size(), query) == 0; ++it)
+  {
+    PetCategory c = it->slot.category;
+    if (!CategoryVisible(c, exotic))
+      continue;
+    PetInfo const &pet = state.CategoryPets(c)[it->slot.index];
+    if (seen.insert(pet.entry).second)
+      out.push_back(&pet);
+  }
+  return out;
+}
+
+// Typo-tolerant lookup: name keys sharing the most trigrams with the query
+// are re-ranked by edit distance against the query and against the key's
+// prefix of the same length (for names typed only partly). Returns at most
+// `limit` pets within the distance bound, best first.
+static std::vector<BeastmasterRuntime::State::PetSlot> FuzzySearchPets(
+    BeastmasterRuntime::State const &state, LocaleConstant locale,
+    std::string const &query, bool exotic, size_t limit)
+{
+  std::vector<BeastmasterRuntime::State::PetSlot> out;
+  auto const *search = state.Search(locale);
+  if (query.empty() || !search)
+    return out;
+  auto const &keys = search->keys;
+
+  std::vector<uint16> shared(keys.size());
+  ForEachTrigram(query, [&](uint32 g)
+                 {
+                   auto it = search->trigrams.find(g);
+                   if (it != search->trigrams.end())
+                     for (uint32 doc : it->second)
+                       ++shared[doc];
+                 });
+
+  // Hidden categories are dropped before the cut so they cannot crowd out
+  // matches the player may adopt.
+  std::vector<uint32> candidates;
+  for (uint32 doc = 0; doc < shared.size(); ++doc)
+    if (shared[doc] && CategoryVisible(keys[doc].slot.category, exotic))
+      candidates.push_back(doc);
+  size_t const maxCandidates = std::min<size_t>(candidates.size(), 64);
+  std::partial_sort(candidates.begin(), candidates.begin() + maxCandidates,
+                    candidates.end(), [&](uint32 a, uint32 b)
+                    { return shared[a] > shared[b]; });
+  candidates.resize(maxCandidates);
+
+  uint32 const bound = std::max<uint32>(2, uint32(query.size()) / 3);
+  struct Ranked
+  {
+    uint32 distance;
+    uint32 doc;
+  };
+  std::vector<Ranked> ranked;
+  for (uint32 doc : candidates)
+  {
+    std::string_view key = keys[doc].key;
+    uint32 d = std::min(BoundedEditDistance(query, key, bound),
+                        BoundedEditDistance(query, key.substr(0, query.size()), bound));
+    if (d <= bound)
+      ranked.push_back({d, doc});
+  }
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [&](Ranked const &a, Ranked const &b)
+                   {
+                     if (a.distance != b.distance)
+                       return a.distance < b.distance;
+                     return shared[a.doc] > shared[b.doc];
+                   });
+
+  std::unordered_set<uint32> seen;
+  for (auto const &r : ranked)
+  {
+    auto const &slot = keys[r.doc].slot;
+    if (seen.insert(state.CategoryPets(slot.category)[slot.index].entry).second)
+      out.push_back(slot);
+    if (out.size() >= limit)
+      break;
+  }
+  return out;
+}
+
+// Times typo'd lookups of catalog names (one letter dropped) so the load log
+// shows what a fuzzy search costs on this catalog. Debug only: runs after a
+// load has published when BeastMaster.DebugSearchTiming is set.
+static void TimeFuzzySearch(BeastmasterRuntime::State const &state)
+{
+  auto const *search = state.Search(LOCALE_enUS);
+  if (!search || search->keys.empty())
+    return;
+  using Clock = std::chrono::steady_clock;
+  auto const &keys = search->keys;
+  size_t const step = std::max<size_t>(1, keys.size() / 256);
+  Clock::duration total{}, worst{};
+  uint32 queries = 0;
+  for (size_t i = 0; i < keys.size(); i += step)
+  {
+    std::string query = keys[i].key;
+    if (query.size() < 4)
+      continue;
+    query.erase(query.size() / 2, 1);
+    auto start = Clock::now();
+    FuzzySearchPets(state, LOCALE_enUS, query, true, BeastmasterRuntime::Gossip::PageSize);
+    auto took = Clock::now() - start;
+    total += took;
+    worst = std::max(worst, took);
+    ++queries;
+  }
+  if (!queries)
+    return;
+  auto us = [](Clock::duration d)
+  { return int64(std::chrono::duration_cast<std::chrono::microseconds>(d).count()); };
+  LOG_INFO("module", "Beastmaster: Fuzzy search timed over {} of {} keys: avg {} us, max {} us.",
+           queries, keys.size(), us(total) / queries, us(worst));
+}
+
+static char const *PetCategoryName(PetCategory c)
+{
+  switch (c)
+  {
+  case PetCategory::Exotic:
+    return "exotic";
+  case PetCategory::Rare:
+    return "rare";
+  case PetCategory::RareExotic:
+    return "rare exotic";
+  default:
+    return "normal";
+  }
+}
+
+// --- Binary catalog cache ---------------------------------------------------
+// Snapshot of the built catalog stored next to the module config. It is only
+// used when both the beastmaster_tames_version marker and the rare entry
+// lists match what it was built from; anything else falls back to the DB.
+// Levels come from creature_template, which the marker does not cover, so
+// they are not cached and are read fresh whenever the catalog is rebuilt.
+//
+// Layout (little endian):
+//   header  { magic, version, catalogVersion, configKey, count, payloadSize,
+//             payloadChecksum }
+//   payload count x { entry, family, icon, category:u8, rarityLen:u8,
+//                     nameLen:u16, rarity, name }
+namespace CatalogCache
+{
+  constexpr uint32 Magic = 0x544D4D42; // "BMMT"
+  constexpr uint32 Version = 4;
+
+  struct Header
+  {
+    uint32 magic;
+    uint32 version;
+    uint64 catalogVersion;
+    uint64 configKey;
+    uint32 count;
+    uint32 payloadSize;
+    uint64 payloadChecksum;
+  };
+
+  static uint64 Fnv1a(void const *data, size_t size,
+                      uint64 hash = 14695981039346656037ULL)
+  {
+    auto const *p = static_cast<uint8 const *>(data);
+    for (size_t i = 0; i < size; ++i)
+      hash = (hash ^ p[i]) * 1099511628211ULL;
+    return hash;
+  }
+
+
+  // Rare entry lists decide categories, so they are part of the cache key.
+  static uint64 ConfigKey(BeastmasterRuntime::State const &state)
+  {
+    uint64 hash = Fnv1a(&Version, sizeof(Version));
+    for (uint32 e : state.rarePetEntries)
+      hash = Fnv1a(&e, sizeof(e), hash);
+    uint32 const separator = 0xFFFFFFFF;
+    hash = Fnv1a(&separator, sizeof(separator), hash);
+    for (uint32 e : state.rareExoticPetEntries)
+      hash = Fnv1a(&e, sizeof(e), hash);
+    return hash;
+  }
+
+  // Single-row marker bumped by triggers on every beastmaster_tames write
+  // (data/sql/db-world/beastmaster_tames.sql), so checking it is one primary
+  // key lookup. 0 if the marker table is missing, which disables the cache
+  // and change polling.
+  static char const *const VersionQuery =
+      "SELECT version FROM beastmaster_tames_version WHERE id = 1";
+
+  static uint64 CatalogVersion()
+  {
+    QueryResult r = WorldDatabase.Query(VersionQuery);
+    if (!r)
+    {
+      LOG_WARN("module", "Beastmaster: beastmaster_tames_version missing; catalog cache "
+                         "and change polling are off (apply data/sql/db-world/beastmaster_tames_version.sql).");
+      return 0;
+    }
+    return (*r)[0].Get<uint64>();
+  }
+
+  // Marks the catalog changed without a row trigger firing, for TRUNCATE and
+  // bulk imports; run before CatalogVersion() on an explicit reload.
+  static void BumpCatalogVersion()
+  {
+    WorldDatabase.DirectExecute(
+        "UPDATE beastmaster_tames_version SET version = version + 1 WHERE id = 1");
+  }
+
+  // Read-only view of the cache file; mmap where available.
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(std::string const &path)
+    {
+#ifndef _WIN32
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return;
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+        void *p = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
+        {
+          _data = static_cast<uint8 const *>(p);
+          _size = size_t(st.st_size);
+        }
+      }
+      ::close(fd);
+#else
+      std::ifstream f(path, std::ios::binary);
+      if (!f)
+        return;
+      _buffer.assign(std::istreambuf_iterator<char>(f), {});
+      _data = reinterpret_cast<uint8 const *>(_buffer.data());
+      _size = _buffer.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+      if (_data)
+        ::munmap(const_cast<uint8 *>(_data), _size);
+#endif
+    }
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+
+    uint8 const *data() const { return _data; }
+    size_t size() const { return _size; }
+
+  private:
+    uint8 const *_data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    std::string _buffer;
+#endif
+  };
+
+  template <typename T>
+  static void Put(std::string &out, T const &v)
+  {
+    out.append(reinterpret_cast<char const *>(&v), sizeof(T));
+  }
+
+  template <typename T>
+  static bool Take(uint8 const *&p, uint8 const *end, T &v)
+  {
+    if (size_t(end - p) < sizeof(T))
+      return false;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+
+  static bool Load(BeastmasterRuntime::State const &state,
+                   uint64 catalogVersion, CatalogRows &pets)
+  {
+    MappedFile file(state.config.catalogCachePath);
+    if (!file.data() || file.size() < sizeof(Header))
+      return false;
+
+    Header h;
+    std::memcpy(&h, file.data(), sizeof(h));
+    uint8 const *p = file.data() + sizeof(Header);
+    uint8 const *end = file.data() + file.size();
+    if (h.magic != Magic || h.version != Version ||
+        h.catalogVersion != catalogVersion || h.configKey != ConfigKey(state) ||
+        h.payloadSize != size_t(end - p) ||
+        h.payloadChecksum != Fnv1a(p, h.payloadSize))
+      return false;
+
+    pets.clear();
+    pets.reserve(h.count);
+    for (uint32 i = 0; i < h.count; ++i)
+    {
+      PetInfo info;
+      uint8 category, rarityLen;
+      uint16 nameLen;
+      if (!Take(p, end, info.entry) || !Take(p, end, info.family) ||
+          !Take(p, end, info.icon) || !Take(p, end, category) ||
+          !Take(p, end, rarityLen) || !Take(p, end, nameLen) ||
+          size_t(end - p) < size_t(rarityLen) + nameLen ||
+          category >= uint8(PetCategory::Count))
+        return false;
+      info.rarity.assign(reinterpret_cast<char const *>(p), rarityLen);
+      p += rarityLen;
+      info.name.assign(reinterpret_cast<char const *>(p), nameLen);
+      p += nameLen;
+      pets.emplace_back(std::move(info), PetCategory(category));
+    }
+    return p == end;
+  }
+
+  static void Save(BeastmasterRuntime::State const &state,
+                   uint64 catalogVersion, CatalogRows const &pets)
+  {
+    std::string payload;
+    payload.reserve(pets.size() * 48);
+    for (auto const &[info, category] : pets)
+    {
+      uint8 rarityLen = uint8(std::min<size_t>(info.rarity.size(), 0xFF));
+      uint16 nameLen = uint16(std::min<size_t>(info.name.size(), 0xFFFF));
+      Put(payload, info.entry);
+      Put(payload, info.family);
+      Put(payload, info.icon);
+      Put(payload, uint8(category));
+      Put(payload, rarityLen);
+      Put(payload, nameLen);
+      payload.append(info.rarity, 0, rarityLen);
+      payload.append(info.name, 0, nameLen);
+    }
+
+    Header h{Magic, Version, catalogVersion, ConfigKey(state),
+             uint32(pets.size()), uint32(payload.size()),
+             Fnv1a(payload.data(), payload.size())};
+
+    // Write beside the target and rename so readers never see a partial file.
+    std::string const &path = state.config.catalogCachePath;
+    std::string tmp = path + ".tmp";
+    {
+      std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+      if (f)
+      {
+        f.write(reinterpret_cast<char const *>(&h), sizeof(h));
+        f.write(payload.data(), std::streamsize(payload.size()));
+        f.close();
+      }
+      if (!f)
+      {
+        LOG_WARN("module", "Beastmaster: Could not write catalog cache '{}'.", tmp);
+        std::remove(tmp.c_str());
+        return;
+      }
+    }
+    std::remove(path.c_str());
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+      LOG_WARN("module", "Beastmaster: Could not replace catalog cache '{}'.", path);
+      std::remove(tmp.c_str());
+    }
+  }
+} // namespace CatalogCache
+
+// --- Schema verification (non-fatal) ----------------------------------------
+// Only warns if expected tables/columns are missing; nothing is migrated.
+// One information_schema query per database, repeated only when that
+// database's update marker moves.
+namespace SchemaCheck
+{
+  // AzerothCore's DB updater records every applied file in `updates`, so its
+  // row count and newest timestamp change whenever the schema may have.
+  // Empty if there is no such table, in which case we always verify.
+  template <typename Pool>
+  static std::string Marker(Pool &db)
+  {
+    QueryResult r = db.Query(
+        "SELECT CONCAT(COUNT(*), '/', IFNULL(MAX(timestamp), '')) FROM updates");
+    return r ? (*r)[0].Get<std::string>() : std::string();
+  }
+
+  template <typename Pool>
+  static void Verify(Pool &db, char const *table,
+                     std::initializer_list<char const *> expected,
+                     bool optional)
+  {
+    QueryResult r = db.Query("SELECT COLUMN_NAME FROM information_schema.COLUMNS "
+                             "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '{}'",
+                             table);
+    if (!r)
+    {
+      if (optional)
+        LOG_WARN("module", "Beastmaster: Optional characters table '{}' missing (tracking disabled).", table);
+      else
+        LOG_ERROR("module", "Beastmaster: Expected world table '{}' missing. Pets cannot load.", table);
+      return;
+    }
+
+    std::set<std::string> cols;
+    do
+    {
+      cols.insert(r->Fetch()[0].Get<std::string>());
+    } while (r->NextRow());
+
+    std::string missing;
+    for (char const *c : expected)
+      if (!cols.count(c))
+      {
+        if (!missing.empty())
+          missing += ",";
+        missing += c;
+      }
+    if (!missing.empty())
+      LOG_WARN("module", "Beastmaster: Table '{}' missing columns: {}. {}", table,
+               missing, optional ? "Tracking may fail." : "Module may misbehave.");
+  }
+
+  // Called from the loader thread only, so the cached markers need no lock.
+  static void Run()
+  {
+    static std::optional<std::string> worldMarker, charMarker;
+
+    std::string marker = Marker(WorldDatabase);
+    if (marker.empty() || marker != worldMarker)
+    {
+      Verify(WorldDatabase, "beastmaster_tames",
+             {"entry", "name", "family", "rarity"}, false);
+      worldMarker = marker;
+    }
+
+    marker = Marker(CharacterDatabase);
+    if (marker.empty() || marker != charMarker)
+    {
+      Verify(CharacterDatabase, "beastmaster_tamed_pets",
+             {"owner_guid", "entry", "name", "date_tamed", "last_summoned"}, true);
+      charMarker = marker;
+    }
+  }
+} // namespace SchemaCheck
+
+// --- Deferred player notices ---------------------------------------------
+// Work finishing off the map threads cannot touch sessions; it queues the
+// text here and the player's own update delivers it.
+static void QueuePlayerNotice(uint64 guid, std::string message)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::lock_guard<std::mutex> lock(rt.noticesMutex);
+  auto &pending = rt.notices[guid];
+  pending.expires = time(nullptr) + 60;
+  pending.lines.push_back(std::move(message));
+  rt.hasNotices.store(true, std::memory_order_relaxed);
+}
+
+static void DeliverNotices(Player *player)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::vector<std::string> pending;
+  {
+    std::lock_guard<std::mutex> lock(rt.noticesMutex);
+    time_t now = time(nullptr);
+    uint64 guid = player->GetGUID().GetRawValue();
+    for (auto it = rt.notices.begin(); it != rt.notices.end();)
+    {
+      if (it->first == guid)
+        pending = std::move(it->second.lines);
+      if (it->first == guid || it->second.expires < now)
+        it = rt.notices.erase(it);
+      else
+        ++it;
+    }
+    rt.hasNotices.store(!rt.notices.empty(), std::memory_order_relaxed);
+  }
+  for (auto const &message : pending)
+    ChatHandler(player->GetSession()).SendSysMessage(message);
+}
+
 /*static*/ NpcBeastmaster *NpcBeastmaster::instance()
 {
   static NpcBeastmaster instance;
   return &instance;
 }
 
-void NpcBeastmaster::LoadSystem(bool /*reload = false*/)
+// creature_template levels of the catalog pets, keyed by entry. Only read
+// when the catalog is rebuilt; level edits alone need a .beastmaster reload,
+// which bumps the version marker.
+using CatalogLevels = std::unordered_map<uint32, std::pair<uint8, uint8>>;
+
+static CatalogLevels LoadCatalogLevels()
 {
-  auto &rt = BeastmasterRuntime::Instance();
-  std::lock_guard<std::mutex> lock(rt.petsMutex);
+  CatalogLevels levels;
+  QueryResult result = WorldDatabase.Query(
+      "SELECT ct.entry, ct.minlevel, ct.maxlevel FROM beastmaster_tames bt "
+      "JOIN creature_template ct ON ct.entry = bt.entry ORDER BY ct.entry");
+  while (result)
+  {
+    Field *fields = result->Fetch();
+    uint32 entry = fields[0].Get<uint32>();
+    uint8 minLevel = fields[1].Get<uint8>();
+    uint8 maxLevel = fields[2].Get<uint8>();
+    levels.emplace(entry, std::make_pair(minLevel, maxLevel));
+    if (!result->NextRow())
+      break;
+  }
+  return levels;
+}
 
-  // --- Basic schema verification (non-fatal) -----------------------------
-  // We don't migrate here, only warn if expected tables/columns missing.
-  auto VerifySchema = []()
+// Fills state's pet lists for the given catalog version, diffing against
+// `previous`; a reload that changed neither the table nor the rare lists
+// reuses them as is. An empty table gives an empty catalog; false only if the
+// pet table is missing.
+static bool BuildCatalog(BeastmasterRuntime::State &state,
+                         BeastmasterRuntime::State const &previous,
+                         uint64 catalogVersion)
+{
+  auto loadStart = std::chrono::steady_clock::now();
+  char const *source = "previous state";
+  uint32 rebuilt = 0;
+
+  if (catalogVersion && catalogVersion == previous.catalogVersion &&
+      previous.PetCount() &&
+      state.rarePetEntries == previous.rarePetEntries &&
+      state.rareExoticPetEntries == previous.rareExoticPetEntries)
+  {
+    state.pets = previous.pets;
+    state.petSlots = previous.petSlots;
+    state.families = previous.families;
+  }
+  else
   {
-    struct TableCheck
+    CatalogRows rows;
+    source = "cache";
+    if (!state.config.catalogCache || !catalogVersion ||
+        !CatalogCache::Load(state, catalogVersion, rows))
     {
-      const char *name;
-      const char *cols;
-    };
-    // Expected columns expressed as a comma separated list for quick LIKE matching.
-    // NOTE: This is a lightweight heuristic, not a strict checksum.
-    TableCheck worldTable{"beastmaster_tames", "entry,name,family,rarity"};
-    TableCheck charTable{"beastmaster_tamed_pets", "owner_guid,entry,name,date_tamed"};
+      source = "database";
+      rows.clear();
 
-    // helper lambda to check existence
-    auto HasTable = [](const char *table, bool world) -> bool
-    {
-      QueryResult r = (world ? WorldDatabase.Query("SHOW TABLES LIKE '{}'", table)
-                             : CharacterDatabase.Query("SHOW TABLES LIKE '{}'", table));
-      return r != nullptr; };
-    auto Columns = [](const char *table, bool world) -> std::set<std::string>
-    {
-      std::set<std::string> out; QueryResult r = (world ? WorldDatabase.Query("SHOW COLUMNS FROM {}", table)
-                                                        : CharacterDatabase.Query("SHOW COLUMNS FROM {}", table));
-      if (!r) return out; do { Field* f = r->Fetch(); out.insert(f[0].Get<std::string>()); } while (r->NextRow()); return out; };
+      QueryResult result = WorldDatabase.Query(
+          "SELECT entry, name, family, rarity FROM beastmaster_tames");
+      if (!result && !WorldDatabase.Query("SHOW TABLES LIKE 'beastmaster_tames'"))
+      {
+        LOG_ERROR(
+            "module",
+            "Beastmaster: Could not load tames from beastmaster_tames table!");
+        return false;
+      }
 
-    // beastmaster_tames (world)
-    if (!HasTable(worldTable.name, true))
-    {
-      LOG_ERROR("module", "Beastmaster: Expected world table '{}' missing. Pets cannot load.", worldTable.name);
-    }
-    else
-    {
-      auto cols = Columns(worldTable.name, true);
-      std::vector<std::string> missing;
-      for (auto &c : {"entry", "name", "family", "rarity"})
-        if (!cols.count(c))
-          missing.push_back(c);
-      if (!missing.empty())
+      rows.reserve(result ? result->GetRowCount() : 0);
+      while (result)
       {
-        std::string joined;
-        for (size_t i = 0; i < missing.size(); ++i)
-        {
-          if (i)
-            joined += ",";
-          joined += missing[i];
-        }
-        LOG_WARN("module", "Beastmaster: Table '{}' missing columns: {}. Module may misbehave.", worldTable.name, joined);
+        Field *fields = result->Fetch();
+        PetInfo info;
+        info.entry = fields[0].Get<uint32>();
+        info.name = fields[1].Get<std::string>();
+        info.family = fields[2].Get<uint32>();
+        info.rarity = fields[3].Get<std::string>();
+        info.icon = PetIconForFamily(info.family);
+        PetCategory category = ClassifyPet(state, info);
+        rows.emplace_back(std::move(info), category);
+        if (!result->NextRow())
+          break;
       }
+
+      if (state.config.catalogCache && catalogVersion)
+        CatalogCache::Save(state, catalogVersion, rows);
     }
-    // beastmaster_tamed_pets (characters)
-    if (!HasTable(charTable.name, false))
+
+    // Pets without a creature_template row keep level 0 (always shown).
+    CatalogLevels levels = LoadCatalogLevels();
+    for (auto &[info, category] : rows)
     {
-      LOG_WARN("module", "Beastmaster: Optional characters table '{}' missing (tracking disabled).", charTable.name);
+      auto it = levels.find(info.entry);
+      if (it != levels.end())
+        std::tie(info.minLevel, info.maxLevel) = it->second;
     }
-    else
+    rebuilt = AssembleCatalog(state, previous, rows);
+  }
+  state.catalogVersion = catalogVersion;
+
+  auto loadMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - loadStart)
+                    .count();
+  LOG_INFO("module", "Beastmaster: Catalog loaded from {} in {} ms ({} of {} categories rebuilt).",
+           source, int64(loadMs), rebuilt, uint32(PetCategory::Count));
+
+  // Post-load logging summary
+  LOG_INFO("module", "Beastmaster: Loaded pets - total={}, normal={}, exotic={}, rare={}, rare_exotic={}",
+           state.PetCount(), state.CategoryPets(PetCategory::Normal).size(),
+           state.CategoryPets(PetCategory::Exotic).size(),
+           state.CategoryPets(PetCategory::Rare).size(),
+           state.CategoryPets(PetCategory::RareExotic).size());
+  if (!state.PetCount())
+  {
+    LOG_ERROR("module", "Beastmaster: No pets loaded! Check beastmaster_tames table/import.");
+  }
+  return true;
+}
+
+// Module-local spawn buckets: 64x64 squares of grid size (533.33 yards)
+// with the map origin in the middle. Only the size matches the core grid; the
+// numbering does not, so these are not GridCoord values.
+static constexpr float SpawnCellSize = 533.3333f;
+static constexpr int32 SpawnCellsPerSide = 64;
+
+static int32 SpawnCellCoord(float v)
+{
+  return std::clamp(int32(std::floor(v / SpawnCellSize)) + SpawnCellsPerSide / 2,
+                    0, SpawnCellsPerSide - 1);
+}
+
+static uint32 SpawnCellKey(uint32 map, int32 cx, int32 cy)
+{
+  return (map << 12) | (uint32(cx) << 6) | uint32(cy);
+}
+
+// Reads the spawns of every catalog entry once; gossip queries are then
+// answered from memory.
+static std::shared_ptr<BeastmasterRuntime::State::SpawnIndex const>
+BuildSpawnIndex(BeastmasterRuntime::State const &state)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto index = std::make_shared<BeastmasterRuntime::State::SpawnIndex>();
+  uint32 spawnCount = 0;
+
+  QueryResult result = WorldDatabase.Query(
+      "SELECT c.id1, c.map, c.zoneId, c.position_x, c.position_y FROM creature c "
+      "JOIN beastmaster_tames bt ON bt.entry = c.id1");
+  if (result)
+  {
+    do
     {
-      auto cols = Columns(charTable.name, false);
-      std::vector<std::string> missing;
-      for (auto &c : {"owner_guid", "entry", "name", "date_tamed"})
-        if (!cols.count(c))
-          missing.push_back(c);
-      if (!missing.empty())
-      {
-        std::string joined;
-        for (size_t i = 0; i < missing.size(); ++i)
-        {
-          if (i)
-            joined += ",";
-          joined += missing[i];
-        }
-        LOG_WARN("module", "Beastmaster: Table '{}' missing columns: {}. Tracking may fail.", charTable.name, joined);
-      }
+      Field *fields = result->Fetch();
+      uint32 entry = fields[0].Get<uint32>();
+      if (!state.FindPet(entry))
+        continue;
+      uint32 map = fields[1].Get<uint16>();
+      uint32 zone = fields[2].Get<uint16>();
+      if (zone)
+        index->byZone[zone].push_back(entry);
+      else
+        index->byCell[SpawnCellKey(map, SpawnCellCoord(fields[3].Get<float>()),
+                                   SpawnCellCoord(fields[4].Get<float>()))]
+            .push_back(entry);
+      ++spawnCount;
+    } while (result->NextRow());
+  }
+
+  size_t bytes = 0;
+  for (auto *buckets : {&index->byZone, &index->byCell})
+    for (auto &[key, entries] : *buckets)
+    {
+      std::sort(entries.begin(), entries.end());
+      entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+      entries.shrink_to_fit();
+      bytes += sizeof(key) + sizeof(entries) + entries.capacity() * sizeof(uint32);
     }
-  }; // VerifySchema
 
-  VerifySchema();
+  auto buildMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  LOG_INFO("module", "Beastmaster: Spawn index built in {} ms ({} spawns, {} zones, {} grid cells, ~{} KB).",
+           int64(buildMs), spawnCount, index->byZone.size(), index->byCell.size(),
+           (bytes + 1023) / 1024);
+  return index;
+}
+
+// Loads every locale's catalog names in one query.
+static void BuildLocalizedNames(BeastmasterRuntime::State &state)
+{
+  using LocalizedNames = BeastmasterRuntime::State::LocalizedNames;
+  std::array<std::shared_ptr<LocalizedNames>, TOTAL_LOCALES> names;
+
+  QueryResult result = WorldDatabase.Query(
+      "SELECT ctl.entry, ctl.locale, ctl.Name FROM creature_template_locale ctl "
+      "JOIN beastmaster_tames bt ON bt.entry = ctl.entry "
+      "WHERE ctl.Name IS NOT NULL AND ctl.Name <> ''");
+  if (result)
+  {
+    do
+    {
+      Field *fields = result->Fetch();
+      uint32 entry = fields[0].Get<uint32>();
+      LocaleConstant locale = GetLocaleByName(fields[1].Get<std::string>());
+      if (locale == LOCALE_enUS || locale >= TOTAL_LOCALES || !state.FindPet(entry))
+        continue;
+      auto &table = names[locale];
+      if (!table)
+        table = std::make_shared<LocalizedNames>();
+      std::string name = fields[2].Get<std::string>();
+      std::string key = CollationKey(name);
+      table->spans[entry] = {uint32(table->arena.size()), uint32(name.size()),
+                             uint32(key.size())};
+      table->arena += name;
+      table->arena += key;
+    } while (result->NextRow());
+  }
+
+  for (size_t locale = 0; locale < names.size(); ++locale)
+    state.localeNames[locale] = std::move(names[locale]);
+}
+
+// Catalog pets spawned in the player's zone, plus zone-less spawns in the
+// player's grid cell and the cells around it, in category order and then the
+// player's locale order.
+static std::vector<PetInfo const *> PetsNearPlayer(BeastmasterRuntime::State const &state,
+                                                   Player *player, bool exotic)
+{
+  std::vector<uint32> entries;
+  if (!state.spawns)
+    return {};
+  auto append = [&](auto const &buckets, uint32 key)
+  {
+    auto it = buckets.find(key);
+    if (it != buckets.end())
+      entries.insert(entries.end(), it->second.begin(), it->second.end());
+  };
+  append(state.spawns->byZone, player->GetZoneId());
+  int32 cx = SpawnCellCoord(player->GetPositionX());
+  int32 cy = SpawnCellCoord(player->GetPositionY());
+  for (int32 x = std::max(cx - 1, 0); x <= std::min(cx + 1, SpawnCellsPerSide - 1); ++x)
+    for (int32 y = std::max(cy - 1, 0); y <= std::min(cy + 1, SpawnCellsPerSide - 1); ++y)
+      append(state.spawns->byCell, SpawnCellKey(player->GetMapId(), x, y));
+
+  std::vector<BeastmasterRuntime::State::PetSlot> slots;
+  slots.reserve(entries.size());
+  for (uint32 entry : entries)
+  {
+    auto it = state.petSlots->find(entry);
+    if (it != state.petSlots->end() && CategoryVisible(it->second.category, exotic))
+      slots.push_back(it->second);
+  }
+  LocaleConstant locale = player->GetSession()->GetSessionDbLocaleIndex();
+  auto order = [&](auto const &a, auto const &b)
+  {
+    return std::pair{a.category, state.Order(a.category, locale).PositionOf(a.index)} <
+           std::pair{b.category, state.Order(b.category, locale).PositionOf(b.index)};
+  };
+  std::sort(slots.begin(), slots.end(), order);
+  slots.erase(std::unique(slots.begin(), slots.end(), [&](auto const &a, auto const &b)
+                          { return !order(a, b) && !order(b, a); }),
+              slots.end());
+
+  std::vector<PetInfo const *> pets;
+  pets.reserve(slots.size());
+  for (auto const &slot : slots)
+    pets.push_back(&state.CategoryPets(slot.category)[slot.index]);
+  return pets;
+}
+
+// Snapshots the module options into a fresh State. Runs on the caller's
+// thread so the loader never reads sConfigMgr while a reload may be
+// rewriting it.
+static std::shared_ptr<BeastmasterRuntime::State> ReadRuntimeConfig()
+{
+  auto next = std::make_shared<BeastmasterRuntime::State>();
+  auto &state = *next;
 
-  rt.config.hunterOnly =
+  state.config.hunterOnly =
       sConfigMgr->GetOption<bool>("BeastMaster.HunterOnly", true);
-  rt.config.allowExotic =
+  state.config.allowExotic =
       sConfigMgr->GetOption<bool>("BeastMaster.AllowExotic", false);
-  rt.config.keepPetHappy =
+  state.config.keepPetHappy =
       sConfigMgr->GetOption<bool>("BeastMaster.KeepPetHappy", false);
-  rt.config.minLevel =
+  state.config.minLevel =
       sConfigMgr->GetOption<uint32>("BeastMaster.MinLevel", 10);
-  rt.config.maxLevel =
+  state.config.maxLevel =
       sConfigMgr->GetOption<uint32>("BeastMaster.MaxLevel", 0);
-  rt.config.hunterBeastMasteryRequired = sConfigMgr->GetOption<uint32>(
+  state.config.hunterBeastMasteryRequired = sConfigMgr->GetOption<uint32>(
       "BeastMaster.HunterBeastMasteryRequired", true);
-  rt.config.trackTamedPets =
+  state.config.trackTamedPets =
       sConfigMgr->GetOption<bool>("BeastMaster.TrackTamedPets", false);
-  rt.config.maxTrackedPets =
+  state.config.maxTrackedPets =
       sConfigMgr->GetOption<uint32>("BeastMaster.MaxTrackedPets", 20);
-  rt.config.allowedRaces = ParseAllowedRaces(
+  state.config.trackedKeysetPaging =
+      sConfigMgr->GetOption<bool>("BeastMaster.TrackedPetsKeysetPaging", false);
+  state.config.trackedPrefetchPages = std::min<uint32>(
+      sConfigMgr->GetOption<uint32>("BeastMaster.TrackedPetsPrefetchPages", 2), 10);
+  state.config.catalogCache =
+      sConfigMgr->GetOption<bool>("BeastMaster.CatalogCache", true);
+  state.config.catalogPollInterval =
+      sConfigMgr->GetOption<uint32>("BeastMaster.CatalogPollInterval", 0);
+  state.config.levelFilter =
+      sConfigMgr->GetOption<bool>("BeastMaster.LevelFilter", false);
+  state.config.debugSearchTiming =
+      sConfigMgr->GetOption<bool>("BeastMaster.DebugSearchTiming", false);
+  state.config.allowedRaceMask = ParseIdMask(
       sConfigMgr->GetOption<std::string>("BeastMaster.AllowedRaces", "0"));
-  rt.config.allowedClasses = ParseAllowedClasses(
+  state.config.allowedClassMask = ParseIdMask(
       sConfigMgr->GetOption<std::string>("BeastMaster.AllowedClasses", "0"));
+  state.config.catalogCachePath =
+      sConfigMgr->GetConfigPath() + "mod_npc_beastmaster.catalog.bin";
+  state.rarePetEntries = ParseEntryList(
+      sConfigMgr->GetOption<std::string>("BeastMaster.RarePets", ""));
+  state.rareExoticPetEntries = ParseEntryList(
+      sConfigMgr->GetOption<std::string>("BeastMaster.RareExoticPets", ""));
+  return next;
+}
 
+// Completes a State from ReadRuntimeConfig with the world database. Runs on
+// the loader thread and touches no shared state; returns false if the pet
+// table could not be read.
+static bool BuildRuntimeState(BeastmasterRuntime::State &state,
+                              BeastmasterRuntime::State const &previous)
+{
   // --- Validation & Normalization ---------------------------------------
   // If hunterOnly is set but AllowedClasses contains other classes, log a warning
-  if (rt.config.hunterOnly && !rt.config.allowedClasses.empty() &&
-      (rt.config.allowedClasses.size() != 1 ||
-       !rt.config.allowedClasses.count(CLASS_HUNTER)))
+  if (state.config.hunterOnly &&
+      (state.config.allowedClassMask & ~(1u << CLASS_HUNTER)))
   {
     LOG_WARN("module",
              "Beastmaster: HunterOnly=1 but AllowedClasses contains non-hunter classes. HunterOnly takes precedence.");
   }
 
   // Level bounds sanity
-  if (rt.config.maxLevel != 0 &&
-      rt.config.maxLevel < rt.config.minLevel &&
-      rt.config.minLevel != 0)
+  if (state.config.maxLevel != 0 &&
+      state.config.maxLevel < state.config.minLevel &&
+      state.config.minLevel != 0)
   {
     LOG_WARN("module",
              "Beastmaster: MaxLevel ({}) is lower than MinLevel ({}). Swapping values.",
-             rt.config.maxLevel, rt.config.minLevel);
-    std::swap(rt.config.maxLevel, rt.config.minLevel);
+             state.config.maxLevel, state.config.minLevel);
+    std::swap(state.config.maxLevel, state.config.minLevel);
+  }
+
+  // Fold class/race/level restrictions into the eligibility table.
+  for (uint8 cls = 0; cls < MAX_CLASSES; ++cls)
+  {
+    bool classOk = cls != 0 &&
+                   (!state.config.hunterOnly || cls == CLASS_HUNTER) &&
+                   (!state.config.allowedClassMask ||
+                    (state.config.allowedClassMask & (1u << cls)));
+    state.eligibility.raceMaskByClass[cls] =
+        classOk ? (state.config.allowedRaceMask ? state.config.allowedRaceMask : ~0u)
+                : 0;
   }
+  state.eligibility.minLevel = state.config.minLevel;
+  state.eligibility.levelSpan =
+      (state.config.maxLevel ? state.config.maxLevel : 0x7FFFFFFF) - state.config.minLevel;
+  state.mainMenus = BuildMainMenuVariants(state.config.trackTamedPets);
 
   // TrackTamedPets + MaxTrackedPets logic
-  if (!rt.config.trackTamedPets &&
-      sConfigMgr->GetOption<uint32>("BeastMaster.MaxTrackedPets", 20) == 0)
+  if (!state.config.trackTamedPets && state.config.maxTrackedPets == 0)
   {
     LOG_INFO("module",
              "Beastmaster: Tracking disabled; MaxTrackedPets ignored (set to {}).",
-             rt.config.maxTrackedPets);
+             state.config.maxTrackedPets);
   }
 
-  // Guard against extreme MaxTrackedPets (potential performance issues)
-  if (rt.config.trackTamedPets &&
-      rt.config.maxTrackedPets > 1000 &&
-      rt.config.maxTrackedPets != 0)
+  // Guard against extreme MaxTrackedPets (potential performance issues).
+  // Keyset paging keeps per-player memory bounded, so only warn without it.
+  if (state.config.trackTamedPets && !state.config.trackedKeysetPaging &&
+      (state.config.maxTrackedPets > 1000 || state.config.maxTrackedPets == 0))
   {
     LOG_WARN(
         "module",
-        "Beastmaster: MaxTrackedPets={} is very high and may impact performance.",
-        rt.config.maxTrackedPets);
+        "Beastmaster: MaxTrackedPets={} is very high and may impact performance. "
+        "Consider BeastMaster.TrackedPetsKeysetPaging = 1.",
+        state.config.maxTrackedPets);
   }
 
   // Warn if both AllowExotic for non-hunters and HunterBeastMasteryRequired are set – clarify behavior.
-  if (rt.config.allowExotic &&
-      rt.config.hunterBeastMasteryRequired)
+  if (state.config.allowExotic &&
+      state.config.hunterBeastMasteryRequired)
   {
     LOG_INFO(
         "module",
         "Beastmaster: AllowExotic=1 allows non-hunters exotic pets regardless of HunterBeastMasteryRequired.");
   }
 
-  rt.rarePetEntries = ParseEntryList(
-      sConfigMgr->GetOption<std::string>("BeastMaster.RarePets", ""));
-  rt.rareExoticPetEntries = ParseEntryList(
-      sConfigMgr->GetOption<std::string>("BeastMaster.RareExoticPets", ""));
-  rt.allPets.clear();
-  rt.normalPets.clear();
-  rt.exoticPets.clear();
-  rt.rarePets.clear();
-  rt.rareExoticPets.clear();
-  rt.allPetsByEntry.clear();
-
-  QueryResult result = WorldDatabase.Query(
-      "SELECT entry, name, family, rarity FROM beastmaster_tames");
-  if (!result)
+  if (!BuildCatalog(state, previous, CatalogCache::CatalogVersion()))
+    return false;
+  // Same table version, same entries: spawns and names only change with
+  // creature edits, which .beastmaster reload picks up by bumping the version.
+  if (state.catalogVersion && state.catalogVersion == previous.catalogVersion &&
+      previous.spawns)
   {
-    LOG_ERROR(
-        "module",
-        "Beastmaster: Could not load tames from beastmaster_tames table!");
-    return;
+    state.spawns = previous.spawns;
+    state.localeNames = previous.localeNames;
+  }
+  else
+  {
+    state.spawns = BuildSpawnIndex(state);
+    BuildLocalizedNames(state);
   }
+  BuildDisplayOrders(state, previous);
+  BuildSearchIndexes(state, previous);
+  StampCatalogGeneration(state, previous);
+  return true;
+}
 
-  do
+// Whispers from the NPC, or a system message when opened via command.
+static void BeastmasterReply(Player *player, Creature *creature,
+                             std::string const &text)
+{
+  if (creature)
+    creature->Whisper(text.c_str(), LANG_UNIVERSAL, player);
+  else
+    ChatHandler(player->GetSession()).PSendSysMessage("{}", text);
+}
+
+// Gate for gossip entry points. Once a State is published this is a single
+// atomic load; before that the first caller starts the load and everyone is
+// told to come back instead of blocking the map thread.
+static bool EnsureBeastmasterReady(Player *player, Creature *creature)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  if (rt.ready.load(std::memory_order_acquire))
+    return true;
+
+  if (rt.loadFailed.load(std::memory_order_acquire))
   {
-    Field *fields = result->Fetch();
-    PetInfo info;
-    info.entry = fields[0].Get<uint32>();
-    info.name = fields[1].Get<std::string>();
-    info.family = fields[2].Get<uint32>();
-    info.rarity = fields[3].Get<std::string>();
+    BeastmasterReply(player, creature,
+                     "No pets available (beastmaster_tames table missing?). Contact an administrator.");
+    return false;
+  }
 
-    static const std::set<uint32> TrainerIconFamilies = {
-        1, 2, 3, 4, 7, 8, 9, 10, 15, 20, 21, 30, 24, 31, 25, 34, 27};
+  // Covers forks where the WORLDHOOK_ON_BEFORE_CONFIG_LOAD load never ran.
+  if (sNpcBeastMaster->LoadSystem())
+    LOG_WARN("module", "Beastmaster: Pet lists not loaded at gossip; started lazy LoadSystem().");
+  BeastmasterReply(player, creature,
+                   "I am still gathering my beasts. Please wait a moment and "
+                   "speak to me again.");
+  return false;
+}
 
-    if (TrainerIconFamilies.count(info.family))
-      info.icon = GOSSIP_ICON_TRAINER;
-    else
-      info.icon = GOSSIP_ICON_VENDOR;
+// Claims the single loader slot and runs job on the loader thread. Losers of
+// the exchange return false at once instead of queueing on the mutex.
+static bool RunOnLoader(std::function<void()> job)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  bool idle = false;
+  if (!rt.loading.compare_exchange_strong(idle, true,
+                                          std::memory_order_acq_rel))
+    return false;
 
-    rt.allPets.push_back(info);
-    rt.allPetsByEntry[info.entry] = info;
+  std::lock_guard<std::mutex> lock(rt.loaderMutex);
+  if (rt.loader.joinable())
+    rt.loader.join();
 
-    if (rt.rarePetEntries.count(info.entry))
-      rt.rarePets.push_back(info);
-    else if (rt.rareExoticPetEntries.count(info.entry))
-      rt.rareExoticPets.push_back(info);
-    else if (info.rarity == "exotic")
-      rt.exoticPets.push_back(info);
-    else
-      rt.normalPets.push_back(info);
-  } while (result->NextRow());
+  rt.loader = std::thread(
+      [job = std::move(job)]()
+      {
+        job();
+        BeastmasterRuntime::Instance().loading.store(
+            false, std::memory_order_release);
+      });
+  return true;
+}
 
-  // Post-load logging summary
-  LOG_INFO("module", "Beastmaster: Loaded pets - total={}, normal={}, exotic={}, rare={}, rare_exotic={}",
-           rt.allPets.size(), rt.normalPets.size(), rt.exoticPets.size(), rt.rarePets.size(), rt.rareExoticPets.size());
-  if (rt.allPets.empty())
+bool NpcBeastmaster::LoadSystem(bool reload /*= false*/,
+                                LoadCallback onComplete /*= {}*/)
+{
+  auto next = ReadRuntimeConfig();
+  return RunOnLoader(
+      [reload, next, onComplete = std::move(onComplete)]()
+      {
+        auto &rt = BeastmasterRuntime::Instance();
+        auto start = std::chrono::steady_clock::now();
+        BeastmasterLoadResult result;
+
+        if (reload)
+          CatalogCache::BumpCatalogVersion();
+
+        // A failed load keeps serving the previous state.
+        if (BuildRuntimeState(*next, *rt.Current()))
+        {
+          result.success = true;
+          result.pets = uint32(next->PetCount());
+          rt.keepPetHappy.store(next->config.keepPetHappy,
+                                std::memory_order_relaxed);
+          rt.catalogPollMs.store(next->config.catalogPollInterval * IN_MILLISECONDS,
+                                 std::memory_order_relaxed);
+          rt.Publish(next);
+          rt.configGeneration.fetch_add(1, std::memory_order_release);
+          rt.ready.store(true, std::memory_order_release);
+          rt.loadFailed.store(false, std::memory_order_release);
+        }
+        else if (!rt.ready.load(std::memory_order_acquire))
+          rt.loadFailed.store(true, std::memory_order_release);
+
+        result.durationMs = uint32(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+        LOG_INFO("module", "Beastmaster: Background load {} in {} ms.",
+                 result.success ? "published" : "failed", result.durationMs);
+
+        // Diagnostics only, so they run after the new state is live.
+        SchemaCheck::Run();
+        if (result.success && next->config.debugSearchTiming)
+          TimeFuzzySearch(*next);
+
+        if (onComplete)
+          onComplete(result);
+      });
+}
+
+void NpcBeastmaster::WorldUpdate(uint32 diff)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  rt.catalogPollQueries.ProcessReadyCallbacks();
+
+  uint32 interval = rt.catalogPollMs.load(std::memory_order_relaxed);
+  if (!interval || rt.catalogPollPending)
+    return;
+  if (rt.catalogPollTimer > diff)
   {
-    LOG_ERROR("module", "Beastmaster: No pets loaded! Check beastmaster_tames table/import.");
+    rt.catalogPollTimer -= diff;
+    return;
+  }
+  rt.catalogPollTimer = interval;
+
+  // An unchanged catalog costs one async primary key read per interval.
+  rt.catalogPollPending = true;
+  rt.catalogPollQueries.AddCallback(
+      WorldDatabase.AsyncQuery(CatalogCache::VersionQuery)
+          .WithCallback(
+              [](QueryResult result)
+              {
+                auto &rt = BeastmasterRuntime::Instance();
+                rt.catalogPollPending = false;
+                uint64 version = result ? (*result)[0].Get<uint64>() : 0;
+                if (!version || version == rt.Current()->catalogVersion)
+                  return;
+
+                // Skipped if a load is already running; the next poll retries.
+                RunOnLoader(
+                    [version]()
+                    {
+                      auto &rt = BeastmasterRuntime::Instance();
+                      auto previous = rt.Current();
+
+                      // Same config, so eligibility caches stay valid; only
+                      // pets change.
+                      auto next = std::make_shared<BeastmasterRuntime::State>(*previous);
+                      if (!BuildCatalog(*next, *previous, version))
+                        return;
+                      next->spawns = BuildSpawnIndex(*next);
+                      BuildLocalizedNames(*next);
+                      BuildDisplayOrders(*next, *previous);
+                      BuildSearchIndexes(*next, *previous);
+                      StampCatalogGeneration(*next, *previous);
+                      LOG_INFO("module", "Beastmaster: beastmaster_tames changed; catalog refreshed ({} pets).",
+                               next->PetCount());
+                      rt.Publish(next);
+                      if (next->config.debugSearchTiming)
+                        TimeFuzzySearch(*next);
+                    });
+              }));
+}
+
+void NpcBeastmaster::WaitForLoad()
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  std::lock_guard<std::mutex> lock(rt.loaderMutex);
+  if (rt.loader.joinable())
+    rt.loader.join();
+}
+
+void NpcBeastmaster::InvalidateEligibility(Player *player)
+{
+  if (auto *cache = player->CustomData.Get<BeastmasterEligibility>(
+          "BeastmasterEligibility"))
+    cache->generation = 0;
+}
+
+// Catalog generation of the last menu sent to the player. Stamped from the
+// State loaded before the menu was built, so a swap mid-build only makes the
+// next check stricter.
+static void StampMenuGeneration(Player *player,
+                                BeastmasterRuntime::State const &state)
+{
+  player->CustomData.Set("BeastmasterMenuGeneration",
+                         new BeastmasterUInt32(state.catalogGeneration));
+}
+
+// Browse, letter, family, nearby and search actions carry pages and indexes
+// into the catalog; they only mean the same pets in the generation they were
+// built from.
+static bool IsStaleCatalogAction(Player *player, uint32 action,
+                                 BeastmasterRuntime::State const &state)
+{
+  switch (GossipAction::OpOf(action))
+  {
+  case ActionOp::Browse:
+  case ActionOp::Letters:
+  case ActionOp::Family:
+  case ActionOp::Nearby:
+  case ActionOp::Search:
+    break;
+  default:
+    return false;
   }
+  auto *shown = player->CustomData.Get<BeastmasterUInt32>("BeastmasterMenuGeneration");
+  return !shown || shown->value != state.catalogGeneration;
 }
 
 void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature)
@@ -556,402 +2921,674 @@ void NpcBeastmaster::ShowMainMenu(Player *player, Creature *creature)
   if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
     return;
 
-  // Safety: if pet lists failed to load (e.g. alternate core fork missing the
-  // WORLDHOOK_ON_BEFORE_CONFIG_LOAD timing) attempt a lazy load once.
-  auto &rt = BeastmasterRuntime::Instance();
-  bool needLoad = false;
-  {
-    std::lock_guard<std::mutex> lock(rt.petsMutex);
-    needLoad = rt.allPets.empty();
-  }
-  if (needLoad)
+  if (!EnsureBeastmasterReady(player, creature))
+    return;
+
+  auto state = BeastmasterRuntime::Instance().Current();
+  if (!state->PetCount())
   {
-    LOG_WARN("module", "Beastmaster: Pet lists empty at ShowMainMenu; performing lazy LoadSystem().");
-    sNpcBeastMaster->LoadSystem();
-    std::lock_guard<std::mutex> lock(rt.petsMutex);
-    if (rt.allPets.empty())
-    {
-      if (creature)
-        creature->Whisper("No pets available (beastmaster_tames table empty?). Contact an administrator.", LANG_UNIVERSAL, player);
-      else
-        ChatHandler(player->GetSession()).PSendSysMessage("No pets available (beastmaster_tames table empty?). Contact an administrator.");
-      return;
-    }
+    BeastmasterReply(player, creature,
+                     "No pets available (beastmaster_tames table empty?). Contact an administrator.");
+    return;
   }
 
-  if (rt.config.hunterOnly && player->getClass() != CLASS_HUNTER)
+  uint8 eligible = GetEligibility(player);
+  if (!(eligible & ELIGIBLE_ALLOWED))
   {
-    if (creature)
-      creature->Whisper("I am sorry, but pets are for hunters only.",
-                        LANG_UNIVERSAL, player);
+    // Only the refusal path needs to know which restriction failed.
+    std::string message;
+    if (state->config.hunterOnly && player->getClass() != CLASS_HUNTER)
+      message = "I am sorry, but pets are for hunters only.";
+    else if (state->config.allowedClassMask &&
+             !(state->config.allowedClassMask & (1u << player->getClass())))
+      message = "Your class is not allowed to adopt pets.";
+    else if (state->config.allowedRaceMask &&
+             !(state->config.allowedRaceMask & (1u << player->getRace())))
+      message = "Your race is not allowed to adopt pets.";
+    else if (player->GetLevel() < state->config.minLevel &&
+             state->config.minLevel != 0)
+      message = Acore::StringFormat(
+          "Sorry {}, but you must reach level {} before adopting a pet.",
+          player->GetName(), state->config.minLevel);
     else
-      ChatHandler(player->GetSession())
-          .PSendSysMessage("I am sorry, but pets are for hunters only.");
+      message = Acore::StringFormat(
+          "Sorry {}, but you must be level {} or lower to adopt a pet.",
+          player->GetName(), state->config.maxLevel);
+
+    BeastmasterReply(player, creature, message);
     return;
   }
 
-  if (!rt.config.allowedClasses.empty() &&
-      rt.config.allowedClasses.find(player->getClass()) ==
-          rt.config.allowedClasses.end())
+  ClearGossipMenuFor(player);
+  StampMenuGeneration(player, *state);
+
+  for (auto const &item : state->mainMenus[MainMenuSignature(eligible)])
   {
-    if (creature)
-      creature->Whisper("Your class is not allowed to adopt pets.",
-                        LANG_UNIVERSAL, player);
+    if (item.coded)
+      AddGossipItemFor(player, item.icon, item.text, GOSSIP_SENDER_MAIN,
+                       item.action, SearchPrompt, 0, true);
     else
-      ChatHandler(player->GetSession())
-          .PSendSysMessage("Your class is not allowed to adopt pets.");
-    return;
+      AddGossipItemFor(player, item.icon, item.text, GOSSIP_SENDER_MAIN,
+                       item.action);
   }
 
-  if (!rt.config.allowedRaces.empty() &&
-      rt.config.allowedRaces.find(player->getRace()) ==
-          rt.config.allowedRaces.end())
+  if (creature)
+    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipHello, creature->GetGUID());
+  else
+    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipHello, ObjectGuid::Empty);
+
+  player->PlayDirectSound(BeastmasterRuntime::PET_BEASTMASTER_HOWL);
+}
+
+void NpcBeastmaster::GossipSelect(Player *player, Creature *creature,
+                                  uint32 action)
+{
+  if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
+    return;
+
+  if (!EnsureBeastmasterReady(player, creature))
   {
-    if (creature)
-      creature->Whisper("Your race is not allowed to adopt pets.",
-                        LANG_UNIVERSAL, player);
-    else
-      ChatHandler(player->GetSession())
-          .PSendSysMessage("Your race is not allowed to adopt pets.");
+    CloseGossipMenuFor(player);
     return;
   }
 
-  if (player->GetLevel() < rt.config.minLevel &&
-      rt.config.minLevel != 0)
+  ClearGossipMenuFor(player);
+
+  auto state = BeastmasterRuntime::Instance().Current();
+  if (IsStaleCatalogAction(player, action, *state))
   {
-    std::string messageExperience = Acore::StringFormat(
-        "Sorry {}, but you must reach level {} before adopting a pet.",
-        player->GetName(), rt.config.minLevel);
-    if (creature)
-      creature->Whisper(messageExperience.c_str(), LANG_UNIVERSAL, player);
-    else
-      ChatHandler(player->GetSession())
-          .PSendSysMessage("%s", messageExperience.c_str());
+    BeastmasterReply(player, creature,
+                     "My beasts have moved about since you last looked. "
+                     "Here is how they stand now.");
+    ShowMainMenu(player, creature);
     return;
   }
 
-  if (rt.config.maxLevel != 0 &&
-      player->GetLevel() > rt.config.maxLevel)
+  // One handler per opcode; the action word is passed through so each
+  // handler decodes only the fields it needs.
+  using ActionHandler = void (NpcBeastmaster::*)(Player *, Creature *, uint32);
+  static constexpr ActionHandler handlers[] = {
+      &NpcBeastmaster::HandleRawAction,       // ActionOp::Raw
+      &NpcBeastmaster::HandleMainMenuAction,  // ActionOp::MainMenu
+      &NpcBeastmaster::HandleBrowseAction,    // ActionOp::Browse
+      &NpcBeastmaster::CreatePet,             // ActionOp::Adopt
+      &NpcBeastmaster::HandleRemoveSkills,    // ActionOp::RemoveSkills
+      &NpcBeastmaster::HandleTrackedMenu,     // ActionOp::TrackedMenu
+      &NpcBeastmaster::HandleSummonPet,       // ActionOp::TrackedSummon
+      &NpcBeastmaster::HandleRenamePet,       // ActionOp::TrackedRename
+      &NpcBeastmaster::HandleDeletePet,       // ActionOp::TrackedDelete
+      &NpcBeastmaster::HandleSearchAction,    // ActionOp::Search
+      &NpcBeastmaster::HandleFamilyAction,    // ActionOp::Family
+      &NpcBeastmaster::HandleLettersAction,   // ActionOp::Letters
+      &NpcBeastmaster::HandleNearbyAction};   // ActionOp::Nearby
+  static_assert(std::size(handlers) == size_t(ActionOp::Count),
+                "every ActionOp needs a handler");
+
+  size_t op = size_t(GossipAction::OpOf(action));
+  if (op < std::size(handlers))
+    (this->*handlers[op])(player, creature, action);
+  StampMenuGeneration(player, *state);
+}
+
+void NpcBeastmaster::HandleRawAction(Player *player, Creature *creature,
+                                     uint32 action)
+{
+  if (action == GOSSIP_OPTION_STABLEPET)
+    player->GetSession()->SendStablePet(creature->GetGUID());
+  else if (action == GOSSIP_OPTION_VENDOR)
+    player->GetSession()->SendListInventory(creature->GetGUID());
+}
+
+void NpcBeastmaster::HandleMainMenuAction(Player *player, Creature *creature,
+                                          uint32 /*action*/)
+{
+  ShowMainMenu(player, creature);
+}
+
+// Showing exotic pets teaches Beast Mastery to players allowed exotic pets
+// who do not have it yet. False if the player may not see exotic pets.
+bool NpcBeastmaster::GrantExoticAccess(Player *player, Creature *creature)
+{
+  uint8 eligible = GetEligibility(player);
+  if (!(eligible & ELIGIBLE_EXOTIC))
+    return false;
+  if (eligible & ELIGIBLE_NEEDS_BM_TEACH)
   {
-    std::string message = Acore::StringFormat(
-        "Sorry {}, but you must be level {} or lower to adopt a pet.",
-        player->GetName(), rt.config.maxLevel);
-    if (creature)
-      creature->Whisper(message.c_str(), LANG_UNIVERSAL, player);
-    else
-      ChatHandler(player->GetSession()).PSendSysMessage("%s", message.c_str());
-    return;
+    player->addSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
+    InvalidateEligibility(player);
+    std::ostringstream messageLearn;
+    messageLearn << "I have taught you the art of Beast Mastery, "
+                 << player->GetName() << ".";
+    creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
   }
+  return true;
+}
 
-  ClearGossipMenuFor(player);
+void NpcBeastmaster::HandleBrowseAction(Player *player, Creature *creature,
+                                        uint32 action)
+{
+  GossipAction const a = GossipAction::Decode(action);
 
-  AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Pets",
-                   GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::PetsStart);
-  AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Pets",
-                   GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareStart);
+  if (!CategoryVisible(a.category, false) && !GrantExoticAccess(player, creature))
+    return;
+
+  auto state = BeastmasterRuntime::Instance().Current();
+  PetList const &pets = state->CategoryPets(a.category);
+  auto const &order = state->Order(a.category, player->GetSession()->GetSessionDbLocaleIndex());
+  std::vector<uint32> const *view = state->LevelView(order, player->GetLevel());
+  uint32 count = view ? uint32(view->size()) : uint32(pets.size());
+  uint32 pageSize = BeastmasterRuntime::Gossip::PageSize;
+  uint32 maxPage = std::min<uint32>(
+      (count + pageSize - 1) / pageSize, GossipAction::MaxPage);
+  uint32 page = std::clamp<uint32>(a.page, 1, std::max<uint32>(maxPage, 1));
+
+  AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                   GossipAction::Simple(ActionOp::MainMenu));
+
+  if (page > 1)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                     GOSSIP_SENDER_MAIN, GossipAction::Browse(a.category, page - 1));
+
+  if (page < maxPage)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                     GOSSIP_SENDER_MAIN, GossipAction::Browse(a.category, page + 1));
+
+  if (maxPage >= BeastmasterRuntime::Gossip::LetterMenuMinPages)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Jump to Letter..",
+                     GOSSIP_SENDER_MAIN, GossipAction::Letters(a.category, page));
+
+  std::vector<PetInfo const *> pagePets;
+  for (size_t i = size_t(page - 1) * pageSize;
+       i < count && pagePets.size() < pageSize; ++i)
+    pagePets.push_back(&pets[order.IndexAt(view ? (*view)[i] : i)]);
+
+  AddPetsToGossip(player, pagePets);
+  SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+}
+
+void NpcBeastmaster::HandleNearbyAction(Player *player, Creature *creature,
+                                        uint32 action)
+{
+  GossipAction const a = GossipAction::Decode(action);
+  auto state = BeastmasterRuntime::Instance().Current();
+  bool exotic = GetEligibility(player) & ELIGIBLE_EXOTIC;
+  std::vector<PetInfo const *> pets = PetsNearPlayer(*state, player, exotic);
+
+  uint32 pageSize = BeastmasterRuntime::Gossip::PageSize;
+  uint32 maxPage = std::min<uint32>(
+      (uint32(pets.size()) + pageSize - 1) / pageSize, GossipAction::MaxPage);
+  uint32 page = std::clamp<uint32>(a.page, 1, std::max<uint32>(maxPage, 1));
+  size_t begin = std::min(size_t(page - 1) * pageSize, pets.size());
+  size_t end = std::min(begin + pageSize, pets.size());
+
+  if (exotic && std::any_of(pets.begin() + begin, pets.begin() + end,
+                            [&](PetInfo const *pet)
+                            { return !CategoryVisible(state->petSlots->at(pet->entry).category, false); }))
+    GrantExoticAccess(player, creature);
+
+  AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                   GossipAction::Simple(ActionOp::MainMenu));
+  if (pets.empty())
+    AddGossipItemFor(player, GOSSIP_ICON_CHAT, "No tameable pets live in this zone.",
+                     GOSSIP_SENDER_MAIN, GossipAction::Simple(ActionOp::MainMenu));
+  if (page > 1)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                     GOSSIP_SENDER_MAIN, GossipAction::NearbyPage(page - 1));
+  if (page < maxPage)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                     GOSSIP_SENDER_MAIN, GossipAction::NearbyPage(page + 1));
+
+  AddPetsToGossip(player, std::vector<PetInfo const *>(pets.begin() + begin,
+                                                       pets.begin() + end));
+  SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+}
+
+// Letters present in a category, in the player's locale. A letter whose pets
+// fit on one browse page opens it directly; a longer letter opens a second
+// menu with one pick per page, so any pet is at most three clicks from the
+// browse page.
+void NpcBeastmaster::HandleLettersAction(Player *player, Creature *creature,
+                                         uint32 action)
+{
+  GossipAction const a = GossipAction::Decode(action);
+  if (!CategoryVisible(a.category, GetEligibility(player) & ELIGIBLE_EXOTIC))
+    return;
 
-  if (rt.config.allowExotic ||
-      player->HasSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY) ||
-      player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, player->GetActiveSpec()))
+  auto state = BeastmasterRuntime::Instance().Current();
+  LocaleConstant locale = player->GetSession()->GetSessionDbLocaleIndex();
+  auto const &order = state->Order(a.category, locale);
+  auto const &starts = order.letters;
+  PetList const &pets = state->CategoryPets(a.category);
+  std::vector<uint32> const *view = state->LevelView(order, player->GetLevel());
+  uint32 total = uint32(pets.size());
+  uint32 pageSize = BeastmasterRuntime::Gossip::PageSize;
+
+  // Position in the order -> position in the player's level view, and back.
+  auto shown = [&](uint32 position)
   {
-    if (player->getClass() != CLASS_HUNTER)
-    {
-      AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Exotic Pets",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::ExoticStart);
-      AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Exotic Pets",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareExoticStart);
-    }
-    else if (!rt.config.hunterBeastMasteryRequired ||
-             player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY,
-                               player->GetActiveSpec()))
+    return view ? uint32(std::lower_bound(view->begin(), view->end(), position) - view->begin())
+                : position;
+  };
+  auto petAt = [&](uint32 pos) -> PetInfo const &
+  { return pets[order.IndexAt(view ? (*view)[pos] : pos)]; };
+  auto pageOf = [&](uint32 pos)
+  { return std::min<uint32>(pos / pageSize + 1, GossipAction::MaxPage); };
+  auto range = [&](size_t i)
+  {
+    return std::pair{shown(starts[i].position),
+                     shown(i + 1 < starts.size() ? starts[i + 1].position : total)};
+  };
+
+  if (a.index && a.index <= starts.size())
+  {
+    auto [first, end] = range(a.index - 1);
+    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                     GossipAction::Letters(a.category, a.page));
+    // One pick per page, labelled with the letter's first and last pet on
+    // it; the client shows at most GOSSIP_MAX_MENU_ITEMS lines.
+    uint32 items = 1;
+    for (uint32 pos = first; pos < end && items < GOSSIP_MAX_MENU_ITEMS; ++items)
     {
-      AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Exotic Pets",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::ExoticStart);
-      AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Browse Rare Exotic Pets",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareExoticStart);
+      uint32 stop = std::min(end, (pos / pageSize + 1) * pageSize);
+      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1,
+                       Acore::StringFormat("{} - {} (page {})",
+                                           state->PetName(petAt(pos), locale),
+                                           state->PetName(petAt(stop - 1), locale), pageOf(pos)),
+                       GOSSIP_SENDER_MAIN, GossipAction::Browse(a.category, pageOf(pos)));
+      pos = stop;
     }
+    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+    return;
   }
 
-  if (player->getClass() != CLASS_HUNTER &&
-      player->HasSpell(BeastmasterRuntime::PET_SPELL_CALL_PET))
-    AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Unlearn Hunter Abilities",
-                     GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RemoveSkills);
+  AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                   GossipAction::Browse(a.category, a.page));
+  for (size_t i = 0; i < starts.size(); ++i)
+  {
+    auto [first, end] = range(i);
+    if (first == end)
+      continue;
+    bool onePage = first / pageSize == (end - 1) / pageSize;
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1,
+                     Acore::StringFormat("{} ({})", starts[i].letter, end - first),
+                     GOSSIP_SENDER_MAIN,
+                     onePage ? GossipAction::Browse(a.category, pageOf(first))
+                             : GossipAction::Letters(a.category, a.page, uint32(i + 1)));
+  }
+  SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+}
 
-  if (rt.config.trackTamedPets)
-    AddGossipItemFor(player, GOSSIP_ICON_CHAT, "My Tamed Pets",
-                     GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::TrackedPetsMenu);
+static std::string FamilyName(Player *player, uint32 family)
+{
+  if (CreatureFamilyEntry const *entry = sCreatureFamilyStore.LookupEntry(family))
+    if (char const *name = entry->Name[player->GetSession()->GetSessionDbcLocale()];
+        name && *name)
+      return name;
+  return Acore::StringFormat("Family {}", family);
+}
 
-  if (player->getClass() == CLASS_HUNTER)
-    AddGossipItemFor(player, GOSSIP_ICON_TAXI, "Visit Stable",
-                     GOSSIP_SENDER_MAIN, GOSSIP_OPTION_STABLEPET);
+static uint32 VisibleFamilyCount(BeastmasterRuntime::State::FamilyBucket const &bucket,
+                                 bool exotic)
+{
+  uint32 count = 0;
+  for (size_t c = 0; c < bucket.pets.size(); ++c)
+    if (CategoryVisible(PetCategory(c), exotic))
+      count += uint32(bucket.pets[c].size());
+  return count;
+}
 
-  AddGossipItemFor(player, GOSSIP_ICON_MONEY_BAG, "Buy Pet Food",
-                   GOSSIP_SENDER_MAIN, GOSSIP_OPTION_VENDOR);
+void NpcBeastmaster::HandleFamilyAction(Player *player, Creature *creature,
+                                        uint32 action)
+{
+  GossipAction const a = GossipAction::Decode(action);
+  auto state = BeastmasterRuntime::Instance().Current();
+  if (!state->families)
+    return;
+  bool exotic = GetEligibility(player) & ELIGIBLE_EXOTIC;
 
-  if (creature)
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipHello, creature->GetGUID());
-  else
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipHello, ObjectGuid::Empty);
+  // Families the player can see anything in, with their visible counts.
+  std::vector<std::pair<BeastmasterRuntime::State::FamilyBucket const *, uint32>> visible;
+  for (auto const &bucket : *state->families)
+    if (uint32 count = VisibleFamilyCount(bucket, exotic))
+      visible.emplace_back(&bucket, count);
+
+  uint32 const listPageSize = BeastmasterRuntime::Gossip::FamilyPageSize;
+  if (!a.index)
+  {
+    uint32 maxPage = (uint32(visible.size()) + listPageSize - 1) / listPageSize;
+    uint32 page = std::clamp<uint32>(a.page, 1, std::max<uint32>(maxPage, 1));
+
+    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                     GossipAction::Simple(ActionOp::MainMenu));
+    if (page > 1)
+      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                       GOSSIP_SENDER_MAIN, GossipAction::FamilyList(page - 1));
+    if (page < maxPage)
+      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                       GOSSIP_SENDER_MAIN, GossipAction::FamilyList(page + 1));
+
+    size_t end = std::min<size_t>(size_t(page) * listPageSize, visible.size());
+    for (size_t i = size_t(page - 1) * listPageSize; i < end; ++i)
+      AddGossipItemFor(player, GOSSIP_ICON_BATTLE,
+                       Acore::StringFormat("{} ({})",
+                                           FamilyName(player, visible[i].first->family),
+                                           visible[i].second),
+                       GOSSIP_SENDER_MAIN,
+                       GossipAction::FamilyPets(visible[i].first->family, 1));
+
+    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+    return;
+  }
+
+  auto it = std::find_if(visible.begin(), visible.end(), [&](auto const &v)
+                         { return v.first->family == a.index; });
+  if (it == visible.end())
+  {
+    HandleFamilyAction(player, creature, GossipAction::FamilyList(1));
+    return;
+  }
+  auto const &bucket = *it->first;
 
-  player->PlayDirectSound(BeastmasterRuntime::PET_BEASTMASTER_HOWL);
+  // Category by category, each in the player's locale order.
+  LocaleConstant locale = player->GetSession()->GetSessionDbLocaleIndex();
+  std::vector<PetInfo const *> pets;
+  pets.reserve(it->second);
+  for (size_t c = 0; c < bucket.pets.size(); ++c)
+  {
+    if (!CategoryVisible(PetCategory(c), exotic))
+      continue;
+    auto const &order = state->Order(PetCategory(c), locale);
+    std::vector<uint32> positions;
+    positions.reserve(bucket.pets[c].size());
+    for (uint32 i : bucket.pets[c])
+      positions.push_back(order.PositionOf(i));
+    std::sort(positions.begin(), positions.end());
+    for (uint32 p : positions)
+      pets.push_back(&state->CategoryPets(PetCategory(c))[order.IndexAt(p)]);
+  }
+
+  bool hasExotic = !bucket.pets[size_t(PetCategory::Exotic)].empty() ||
+                   !bucket.pets[size_t(PetCategory::RareExotic)].empty();
+  if (exotic && hasExotic)
+    GrantExoticAccess(player, creature);
+
+  uint32 pageSize = BeastmasterRuntime::Gossip::PageSize;
+  uint32 maxPage = std::min<uint32>(
+      (uint32(pets.size()) + pageSize - 1) / pageSize, GossipAction::MaxPage);
+  uint32 page = std::clamp<uint32>(a.page, 1, std::max<uint32>(maxPage, 1));
+  uint32 listPage = uint32(it - visible.begin()) / listPageSize + 1;
+
+  AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                   GossipAction::FamilyList(listPage));
+  if (page > 1)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                     GOSSIP_SENDER_MAIN, GossipAction::FamilyPets(bucket.family, page - 1));
+  if (page < maxPage)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                     GOSSIP_SENDER_MAIN, GossipAction::FamilyPets(bucket.family, page + 1));
+
+  size_t begin = size_t(page - 1) * pageSize;
+  size_t end = std::min(begin + pageSize, pets.size());
+  AddPetsToGossip(player, std::vector<PetInfo const *>(pets.begin() + begin,
+                                                       pets.begin() + end));
+  SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
 }
 
-void NpcBeastmaster::GossipSelect(Player *player, Creature *creature,
-                                  uint32 action)
+void NpcBeastmaster::GossipSelectCode(Player *player, Creature *creature,
+                                      uint32 action, char const *code)
 {
   if (!sConfigMgr->GetOption<bool>("BeastMaster.Enable", true))
     return;
-
-  auto &rt = BeastmasterRuntime::Instance();
-  // Lazy load safeguard for forks where initial LoadSystem hook may not fire.
+  if (!EnsureBeastmasterReady(player, creature))
   {
-    bool emptyNow = false;
-    {
-      std::lock_guard<std::mutex> lock(rt.petsMutex);
-      emptyNow = rt.allPets.empty();
-    }
-    if (emptyNow)
-      sNpcBeastMaster->LoadSystem();
+    CloseGossipMenuFor(player);
+    return;
+  }
+  if (GossipAction::OpOf(action) != ActionOp::Search)
+  {
+    CloseGossipMenuFor(player);
+    return;
   }
 
+  // Pet names are short; a longer query cannot match anything.
+  std::string query = NormalizeSearchKey(std::string_view(code ? code : "").substr(0, 64));
+  auto state = BeastmasterRuntime::Instance().Current();
+  player->CustomData.Set("BeastmasterSearch", new BeastmasterSearch(query));
   ClearGossipMenuFor(player);
+  HandleSearchAction(player, creature, GossipAction::SearchPage(1));
+  StampMenuGeneration(player, *state);
+}
 
-  if (action == BeastmasterRuntime::Gossip::MainMenu)
+void NpcBeastmaster::HandleSearchAction(Player *player, Creature *creature,
+                                        uint32 action)
+{
+  auto *search = player->CustomData.Get<BeastmasterSearch>("BeastmasterSearch");
+  if (!search || search->query.empty())
   {
+    BeastmasterReply(player, creature, "Tell me at least part of the pet's name.");
     ShowMainMenu(player, creature);
+    return;
   }
-  else if (BeastmasterRuntime::IsBrowseNormal(action))
-  {
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     BeastmasterRuntime::Gossip::MainMenu);
-    int page = action - BeastmasterRuntime::Gossip::PetsStart + 1;
-    int maxPage = rt.normalPets.size() / BeastmasterRuntime::Gossip::PageSize +
-                  (rt.normalPets.size() % BeastmasterRuntime::Gossip::PageSize != 0);
-
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::PetsStart + page - 2);
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::PetsStart + page);
+  auto state = BeastmasterRuntime::Instance().Current();
+  bool exotic = GetEligibility(player) & ELIGIBLE_EXOTIC;
+  LocaleConstant locale = player->GetSession()->GetSessionDbLocaleIndex();
+  std::vector<PetInfo const *> matches =
+      SearchPetsByPrefix(*state, locale, search->query, exotic);
 
-    AddPetsToGossip(player, rt.normalPets, page);
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
-  }
-  else if (BeastmasterRuntime::IsBrowseExotic(action))
+  if (matches.empty())
   {
-    if (!(player->HasSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY) ||
-          player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY,
-                            player->GetActiveSpec())))
-    {
-      player->addSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-      std::ostringstream messageLearn;
-      messageLearn << "I have taught you the art of Beast Mastery, "
-                   << player->GetName() << ".";
-      creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
-    }
+    for (auto const &slot : FuzzySearchPets(*state, locale, search->query, exotic,
+                                            BeastmasterRuntime::Gossip::PageSize))
+      matches.push_back(&state->CategoryPets(slot.category)[slot.index]);
+    // Only when the query is typed, not again on every page of it.
+    if (search->submitted)
+      BeastmasterReply(player, creature,
+                       matches.empty()
+                           ? Acore::StringFormat("I know of no pet called '{}'.",
+                                                 search->query)
+                           : Acore::StringFormat("I know of no pet called '{}'. "
+                                                 "Perhaps you meant one of these?",
+                                                 search->query));
+  }
+  search->submitted = false;
+
+  uint32 pageSize = BeastmasterRuntime::Gossip::PageSize;
+  uint32 maxPage = std::min<uint32>(
+      (uint32(matches.size()) + pageSize - 1) / pageSize, GossipAction::MaxPage);
+  uint32 page = std::clamp<uint32>(GossipAction::Decode(action).page, 1,
+                                   std::max<uint32>(maxPage, 1));
+
+
+  AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
+                   GossipAction::Simple(ActionOp::MainMenu));
+  AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Search Again..",
+                   GOSSIP_SENDER_MAIN, GossipAction::SearchPage(1),
+                   SearchPrompt, 0, true);
+  if (page > 1)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                     GOSSIP_SENDER_MAIN, GossipAction::SearchPage(page - 1));
+  if (page < maxPage)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                     GOSSIP_SENDER_MAIN, GossipAction::SearchPage(page + 1));
+
+  size_t begin = size_t(page - 1) * pageSize;
+  size_t end = std::min(begin + pageSize, matches.size());
+  std::vector<PetInfo const *> pagePets;
+  if (begin < end)
+    pagePets.assign(matches.begin() + begin, matches.begin() + end);
+
+  AddPetsToGossip(player, pagePets);
+  SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+}
 
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     BeastmasterRuntime::Gossip::MainMenu);
-    int page = action - BeastmasterRuntime::Gossip::ExoticStart + 1;
-    int maxPage = rt.exoticPets.size() / BeastmasterRuntime::Gossip::PageSize +
-                  (rt.exoticPets.size() % BeastmasterRuntime::Gossip::PageSize != 0);
+void NpcBeastmaster::HandleRemoveSkills(Player *player, Creature * /*creature*/,
+                                        uint32 /*action*/)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  for (auto spell : rt.hunterSpells)
+    player->removeSpell(spell, SPEC_MASK_ALL, false);
 
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::ExoticStart + page - 2);
+  player->removeSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
+  InvalidateEligibility(player);
+  CloseGossipMenuFor(player);
+}
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::ExoticStart + page);
+void NpcBeastmaster::HandleTrackedMenu(Player *player, Creature *creature,
+                                       uint32 action)
+{
+  GossipAction const a = GossipAction::Decode(action);
+  if (a.index && a.index <= uint32(TrackedSort::Count))
+    player->CustomData.Set("BeastmasterTrackedSort", new BeastmasterUInt32(a.index - 1));
+  ShowTrackedPetsMenu(player, creature, std::max<uint32>(a.page, 1));
+}
 
-    AddPetsToGossip(player, rt.exoticPets, page);
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
-  }
-  else if (BeastmasterRuntime::IsBrowseRare(action))
-  {
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     BeastmasterRuntime::Gossip::MainMenu);
-    int page = action - BeastmasterRuntime::Gossip::RareStart + 1;
-    int maxPage = rt.rarePets.size() / BeastmasterRuntime::Gossip::PageSize +
-                  (rt.rarePets.size() % BeastmasterRuntime::Gossip::PageSize != 0);
+// Tracked pet actions carry the entry itself. It is only honoured if the pet is
+// in the player's loaded tracked list, which rejects forged actions and ones
+// left over from a menu shown before a delete.
+static bool ResolveTrackedAction(Player *player, uint32 action, uint32 &entry)
+{
+  TrackedPetRecord rec;
+  entry = GossipAction::Decode(action).index;
+  return TrackedLookup(player, entry, rec);
+}
 
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareStart + page - 2);
+void NpcBeastmaster::HandleSummonPet(Player *player, Creature *creature,
+                                     uint32 action)
+{
+  uint32 entry = 0;
+  if (!ResolveTrackedAction(player, action, entry))
+    return;
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareStart + page);
+  if (player->IsExistPet())
+  {
+    creature->Whisper("First you must abandon or stable your current pet!",
+                      LANG_UNIVERSAL, player);
+    CloseGossipMenuFor(player);
+    return;
+  }
 
-    AddPetsToGossip(player, rt.rarePets, page);
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
+  Pet *pet = player->CreatePet(entry, BeastmasterRuntime::PET_SPELL_CALL_PET);
+  if (pet)
+  {
+    // The menu was built from the tracked cache, so the custom name is
+    // already in memory; no need for a round-trip here.
+    TrackedPetRecord rec;
+    if (TrackedLookup(player, entry, rec) && rec.HasCustomName())
+      pet->SetName(std::string(rec.CustomName()));
+    TrackedCacheTouch(player->GetGUID().GetRawValue(),
+                      player->GetGUID().GetCounter(), entry);
+    pet->SetPower(POWER_HAPPINESS, BeastmasterRuntime::PET_MAX_HAPPINESS);
+    creature->Whisper("Your tracked pet has been summoned!", LANG_UNIVERSAL,
+                      player);
   }
-  else if (BeastmasterRuntime::IsBrowseRareExotic(action))
+  else
   {
-    if (!(player->HasSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY) ||
-          player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY,
-                            player->GetActiveSpec())))
-    {
-      player->addSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-      std::ostringstream messageLearn;
-      messageLearn << "I have taught you the art of Beast Mastery, "
-                   << player->GetName() << ".";
-      creature->Whisper(messageLearn.str().c_str(), LANG_UNIVERSAL, player);
-    }
+    creature->Whisper("Failed to summon pet.", LANG_UNIVERSAL, player);
+  }
+  CloseGossipMenuFor(player);
+}
 
-    AddGossipItemFor(player, GOSSIP_ICON_TALK, "Back..", GOSSIP_SENDER_MAIN,
-                     BeastmasterRuntime::Gossip::MainMenu);
-    int page = action - BeastmasterRuntime::Gossip::RareExoticStart + 1;
-    int maxPage = rt.rareExoticPets.size() / BeastmasterRuntime::Gossip::PageSize +
-                  (rt.rareExoticPets.size() % BeastmasterRuntime::Gossip::PageSize != 0);
+void NpcBeastmaster::HandleRenamePet(Player *player, Creature *creature,
+                                     uint32 action)
+{
+  uint32 entry = 0;
+  if (!ResolveTrackedAction(player, action, entry))
+    return;
 
-    if (page > 1)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareExoticStart + page - 2);
+  player->CustomData.Set("BeastmasterRenamePetEntry",
+                         new BeastmasterUInt32(entry));
+  player->CustomData.Set("BeastmasterExpectRename",
+                         new BeastmasterBool(true));
+  ChatHandler(player->GetSession())
+      .PSendSysMessage("To rename your pet, type: .petname rename <newname> "
+                       "in chat. To cancel, type: .petname cancel");
+  if (creature)
+    creature->Whisper(
+        "To rename your pet, type: .petname rename <newname> in chat. "
+        "To cancel, type: .petname cancel",
+        LANG_UNIVERSAL, player);
+  CloseGossipMenuFor(player);
+}
 
-    if (page < maxPage)
-      AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
-                       GOSSIP_SENDER_MAIN, BeastmasterRuntime::Gossip::RareExoticStart + page);
+void NpcBeastmaster::HandleDeletePet(Player *player, Creature *creature,
+                                     uint32 action)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  uint32 entry = 0;
+  if (!ResolveTrackedAction(player, action, entry))
+    return;
 
-    AddPetsToGossip(player, rt.rareExoticPets, page);
-    SendGossipMenuFor(player, BeastmasterRuntime::Gossip::GossipBrowse, creature->GetGUID());
-  }
-  else if (action == BeastmasterRuntime::Gossip::RemoveSkills)
-  {
-    for (auto spell : rt.hunterSpells)
-      player->removeSpell(spell, SPEC_MASK_ALL, false);
+  CharacterDatabase.Execute("DELETE FROM beastmaster_tamed_pets WHERE "
+                            "owner_guid = {} AND entry = {}",
+                            player->GetGUID().GetCounter(), entry);
 
-    player->removeSpell(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, SPEC_MASK_ALL, false);
-    CloseGossipMenuFor(player);
-  }
-  else if (action == GOSSIP_OPTION_STABLEPET)
-  {
-    player->GetSession()->SendStablePet(creature->GetGUID());
-  }
-  else if (action == GOSSIP_OPTION_VENDOR)
+  uint32 page = TrackedPageOf(player, entry);
+  int32 remaining = TrackedCacheErase(player->GetGUID().GetRawValue(), entry);
+  if (auto *win = GetTrackedWindow(player))
   {
-    player->GetSession()->SendListInventory(creature->GetGUID());
+    // Earlier pages keep their bounds; later ones shift up by one row.
+    auto &rows = win->rows;
+    rows.erase(std::remove_if(rows.begin(), rows.end(),
+                              [entry](TrackedPetRecord const &r)
+                              { return r.entry == entry; }),
+               rows.end());
+    win->RecomputeCursors(BeastmasterRuntime::Tracked::PageSize);
   }
-  else if (BeastmasterRuntime::IsTrackedMenu(action))
+  if (rt.Current()->config.trackTamedPets)
   {
-    uint32 page = action - BeastmasterRuntime::Gossip::TrackedPetsMenu + 1;
-    ShowTrackedPetsMenu(player, creature, page);
-    return;
+    std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
+    auto it = rt.tamedEntriesCache.find(player->GetGUID().GetRawValue());
+    if (it != rt.tamedEntriesCache.end())
+      it->second.erase(entry);
   }
-  else if (BeastmasterRuntime::IsTrackedSummon(action))
+
+  ChatHandler(player->GetSession())
+      .PSendSysMessage("Tracked pet deleted (entry {}).", entry);
+  LOG_INFO("module", "Beastmaster: Player {} deleted tracked pet (entry {}).",
+           player->GetGUID().GetCounter(), entry);
+
+  // Stay on the page the pet was deleted from, unless it is now past the end.
+  if (remaining >= 0)
   {
-    uint32 idx = action - BeastmasterRuntime::Tracked::SummonBase;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-    if (player->IsExistPet())
-    {
-      creature->Whisper("First you must abandon or stable your current pet!",
-                        LANG_UNIVERSAL, player);
-      CloseGossipMenuFor(player);
-      return;
-    }
-    else
-    {
-      Pet *pet = player->CreatePet(entry, BeastmasterRuntime::PET_SPELL_CALL_PET);
-      if (pet)
-      {
-        QueryResult nameResult =
-            CharacterDatabase.Query("SELECT name FROM beastmaster_tamed_pets "
-                                    "WHERE owner_guid = {} AND entry = {}",
-                                    player->GetGUID().GetCounter(), entry);
-        if (nameResult)
-        {
-          std::string customName = (*nameResult)[0].Get<std::string>();
-          pet->SetName(customName);
-        }
-        pet->SetPower(POWER_HAPPINESS, BeastmasterRuntime::PET_MAX_HAPPINESS);
-        creature->Whisper("Your tracked pet has been summoned!", LANG_UNIVERSAL,
-                          player);
-      }
-      else
-      {
-        creature->Whisper("Failed to summon pet.", LANG_UNIVERSAL, player);
-      }
-    }
-    CloseGossipMenuFor(player);
-    return;
+    uint32 maxPage = (uint32(remaining) + BeastmasterRuntime::Tracked::PageSize - 1) /
+                     BeastmasterRuntime::Tracked::PageSize;
+    page = std::clamp<uint32>(page, 1, std::max<uint32>(maxPage, 1));
   }
-  else if (BeastmasterRuntime::IsTrackedRename(action))
+
+  ShowTrackedPetsMenu(player, creature, page);
+}
+
+// Entries the player tracks. Read from the character DB on first use (the
+// adoption menus call this before any pet can be picked) and kept in step by
+// adopt and delete afterwards.
+static std::set<uint32> const &TamedEntries(Player *player)
+{
+  auto &rt = BeastmasterRuntime::Instance();
+  uint64 guid = player->GetGUID().GetRawValue();
   {
-    uint32 idx = action - BeastmasterRuntime::Tracked::RenameBase;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-    player->CustomData.Set("BeastmasterRenamePetEntry",
-                           new BeastmasterUInt32(entry));
-    player->CustomData.Set("BeastmasterExpectRename",
-                           new BeastmasterBool(true));
-    ChatHandler(player->GetSession())
-        .PSendSysMessage("To rename your pet, type: .petname rename <newname> "
-                         "in chat. To cancel, type: .petname cancel");
-    if (creature)
-      creature->Whisper(
-          "To rename your pet, type: .petname rename <newname> in chat. "
-          "To cancel, type: .petname cancel",
-          LANG_UNIVERSAL, player);
-    CloseGossipMenuFor(player);
-    return;
+    std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
+    auto it = rt.tamedEntriesCache.find(guid);
+    if (it != rt.tamedEntriesCache.end())
+      return it->second;
   }
-  else if (BeastmasterRuntime::IsTrackedDelete(action))
-  {
-    uint32 idx = action - BeastmasterRuntime::Tracked::DeleteBase;
-    auto *petMapWrap =
-        player->CustomData.Get<BeastmasterPetMap>("BeastmasterMenuPetMap");
-    if (!petMapWrap || petMapWrap->map.find(idx) == petMapWrap->map.end())
-      return;
-    uint32 entry = petMapWrap->map[idx];
-
-    CharacterDatabase.Execute("DELETE FROM beastmaster_tamed_pets WHERE "
-                              "owner_guid = {} AND entry = {}",
-                              player->GetGUID().GetCounter(), entry);
 
-    sNpcBeastMaster->ClearTrackedPetsCache(player);
-    if (rt.config.trackTamedPets)
+  std::set<uint32> snapshot;
+  QueryResult result = CharacterDatabase.Query(
+      "SELECT entry FROM beastmaster_tamed_pets WHERE owner_guid = {}",
+      player->GetGUID().GetCounter());
+  if (result)
+  {
+    do
     {
-      std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
-      auto it = rt.tamedEntriesCache.find(player->GetGUID().GetRawValue());
-      if (it != rt.tamedEntriesCache.end())
-        it->second.erase(entry);
-    }
-
-    ChatHandler(player->GetSession())
-        .PSendSysMessage("Tracked pet deleted (entry {}).", entry);
-    LOG_INFO("module", "Beastmaster: Player {} deleted tracked pet (entry {}).",
-             player->GetGUID().GetCounter(), entry);
-
-    uint32 totalPets = 0;
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT COUNT(*) FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-        player->GetGUID().GetCounter());
-    if (result)
-      totalPets = (*result)[0].Get<uint32>();
-
-    uint32 page = (idx / BeastmasterRuntime::Tracked::PageSize) + 1;
-    uint32 maxPage =
-        (totalPets + BeastmasterRuntime::Tracked::PageSize - 1) / BeastmasterRuntime::Tracked::PageSize;
-    if (page > maxPage && maxPage > 0)
-      page = maxPage;
-    if (page == 0)
-      page = 1;
-
-    ShowTrackedPetsMenu(player, creature, page);
-    return;
+      Field *fields = result->Fetch();
+      snapshot.insert(fields[0].Get<uint32>());
+    } while (result->NextRow());
   }
-
-  if (BeastmasterRuntime::IsAdoptAction(action))
-    CreatePet(player, creature, action);
+  std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
+  auto &ref = rt.tamedEntriesCache[guid];
+  ref = std::move(snapshot);
+  return ref;
 }
 
 void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
@@ -961,8 +3598,9 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
     return;
 
   auto &rt = BeastmasterRuntime::Instance();
-  uint32 petEntry = action - BeastmasterRuntime::Gossip::PetEntryOffset;
-  const PetInfo *info = FindPetInfo(petEntry);
+  uint32 petEntry = GossipAction::Decode(action).index;
+  auto state = rt.Current();
+  const PetInfo *info = state->FindPet(petEntry);
 
   if (player->IsExistPet())
   {
@@ -973,7 +3611,7 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
   }
 
   if (info && info->rarity == "exotic" && player->getClass() != CLASS_HUNTER &&
-      !rt.config.allowExotic)
+      !state->config.allowExotic)
   {
     creature->Whisper("Only hunters can adopt exotic pets.", LANG_UNIVERSAL,
                       player);
@@ -982,9 +3620,9 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
   }
 
   if (info && info->rarity == "exotic" && player->getClass() == CLASS_HUNTER &&
-      rt.config.hunterBeastMasteryRequired)
+      state->config.hunterBeastMasteryRequired)
   {
-    if (!player->HasTalent(BeastmasterRuntime::PET_SPELL_BEAST_MASTERY, player->GetActiveSpec()))
+    if (!(GetEligibility(player) & ELIGIBLE_BM_TALENT))
     {
       creature->Whisper(
           "You need the Beast Mastery talent to adopt exotic pets.",
@@ -994,15 +3632,32 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
     }
   }
 
-  // Enforce max tracked pets if enabled
-  if (rt.config.trackTamedPets &&
-      rt.config.maxTrackedPets > 0)
+  // Enforce max tracked pets if enabled. The count comes from the cached
+  // tracked list when the tracked menu has loaded it, else from the cached
+  // entries; neither costs a query here.
+  bool alreadyTracked = false;
+  if (state->config.trackTamedPets)
   {
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT COUNT(*) FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-        player->GetGUID().GetCounter());
-    uint32 count = result ? (*result)[0].Get<uint32>() : 0;
-    if (count >= rt.config.maxTrackedPets)
+    size_t count = 0;
+    bool cached = false;
+    {
+      std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+      auto it = rt.trackedPetsCache.find(player->GetGUID().GetRawValue());
+      if (it != rt.trackedPetsCache.end())
+      {
+        cached = true;
+        count = it->second.size();
+        alreadyTracked = it->second.Find(petEntry);
+      }
+    }
+    if (!cached)
+    {
+      std::set<uint32> const &tamed = TamedEntries(player);
+      count = tamed.size();
+      alreadyTracked = tamed.count(petEntry);
+    }
+    if (!alreadyTracked && state->config.maxTrackedPets > 0 &&
+        count >= state->config.maxTrackedPets)
     {
       creature->Whisper("You have reached the maximum number of tracked pets.",
                         LANG_UNIVERSAL, player);
@@ -1021,24 +3676,30 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
     return;
   }
 
-  if (rt.config.trackTamedPets)
+  if (state->config.trackTamedPets && !alreadyTracked)
   {
-    if (BeastmasterDB::TrackTamedPet(player, petEntry, pet->GetName()))
+    BeastmasterDB::TrackTamedPet(player, petEntry, pet->GetName());
     {
       std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
       rt.tamedEntriesCache[player->GetGUID().GetRawValue()].insert(petEntry);
     }
+    TrackedCacheInsert(player->GetGUID().GetRawValue(),
+                       TrackedPetRecord(petEntry, uint32(time(nullptr)),
+                                        pet->GetName(), DefaultPetName(petEntry)));
+    // New pets land on page one, so every keyset bound shifts.
+    ResetTrackedWindow(player);
   }
 
   pet->SetPower(POWER_HAPPINESS, BeastmasterRuntime::PET_MAX_HAPPINESS);
 
   if (player->getClass() != CLASS_HUNTER)
   {
-    if (!player->HasSpell(BeastmasterRuntime::PET_SPELL_CALL_PET))
+    if (!(GetEligibility(player) & ELIGIBLE_CAN_UNLEARN))
     {
       for (auto const &spell : rt.hunterSpells)
         if (!player->HasSpell(spell))
           player->learnSpell(spell);
+      InvalidateEligibility(player);
     }
   }
 
@@ -1051,74 +3712,47 @@ void NpcBeastmaster::CreatePet(Player *player, Creature *creature,
 }
 
 void NpcBeastmaster::AddPetsToGossip(Player *player,
-                                     std::vector<PetInfo> const &pets,
-                                     uint32 page)
+                                     std::vector<PetInfo const *> const &pets)
 {
   auto &rt = BeastmasterRuntime::Instance();
-  const std::set<uint32> *tamedPtr = nullptr;
-  std::set<uint32> snapshot; // temporary if we need to query
-  uint64 guid = player->GetGUID().GetRawValue();
-  if (rt.config.trackTamedPets)
-  {
-    {
-      std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
-      auto it = rt.tamedEntriesCache.find(guid);
-      if (it != rt.tamedEntriesCache.end())
-        tamedPtr = &it->second;
-    }
-    if (!tamedPtr)
-    {
-      QueryResult result = CharacterDatabase.Query(
-          "SELECT entry FROM beastmaster_tamed_pets WHERE owner_guid = {}",
-          player->GetGUID().GetCounter());
-      if (result)
-      {
-        do
-        {
-          Field *fields = result->Fetch();
-          snapshot.insert(fields[0].Get<uint32>());
-        } while (result->NextRow());
-      }
-      {
-        std::lock_guard<std::mutex> lock(rt.tamedEntriesMutex);
-        auto &ref = rt.tamedEntriesCache[guid];
-        ref = std::move(snapshot);
-        tamedPtr = &ref;
-      }
-    }
-  }
   static const std::set<uint32> emptySet;
-  const std::set<uint32> &tamedEntries = tamedPtr ? *tamedPtr : emptySet;
-
-  std::lock_guard<std::mutex> lock(rt.petsMutex);
+  const std::set<uint32> &tamedEntries =
+      rt.Current()->config.trackTamedPets ? TamedEntries(player) : emptySet;
 
-  uint32 count = 1;
-  for (const auto &pet : pets)
+  auto state = rt.Current();
+  LocaleConstant locale = player->GetSession()->GetSessionDbLocaleIndex();
+  for (PetInfo const *pet : pets)
   {
-    if (count > (page - 1) * BeastmasterRuntime::Gossip::PageSize && count <= page * BeastmasterRuntime::Gossip::PageSize)
+    std::string name(state->PetName(*pet, locale));
+    if (tamedEntries.count(pet->entry))
     {
-      if (tamedEntries.count(pet.entry))
-      {
-        AddGossipItemFor(player, GOSSIP_ICON_CHAT,
-                         pet.name + " (Already Tamed)", GOSSIP_SENDER_MAIN,
-                         0); // 0 = no action
-      }
-      else
-      {
-        AddGossipItemFor(player, pet.icon, pet.name, GOSSIP_SENDER_MAIN,
-                         pet.entry + BeastmasterRuntime::Gossip::PetEntryOffset);
-      }
+      AddGossipItemFor(player, GOSSIP_ICON_CHAT,
+                       name + " (Already Tamed)", GOSSIP_SENDER_MAIN,
+                       0); // 0 = no action
+    }
+    else
+    {
+      AddGossipItemFor(player, pet->icon, name, GOSSIP_SENDER_MAIN,
+                       GossipAction::Adopt(pet->entry));
     }
-    count++;
   }
 }
 
 void NpcBeastmaster::ClearTrackedPetsCache(Player *player)
 {
   auto &rt = BeastmasterRuntime::Instance();
-  std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
-  rt.trackedPetsCache.erase(player->GetGUID().GetRawValue());
-  player->CustomData.Erase("BeastmasterMenuPetMap");
+  std::vector<std::pair<uint32, uint32>> pending;
+  {
+    std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+    auto it = rt.trackedPetsCache.find(player->GetGUID().GetRawValue());
+    if (it != rt.trackedPetsCache.end())
+    {
+      pending = it->second.Flush();
+      rt.trackedPetsCache.erase(it);
+    }
+  }
+  FlushTrackedRecency(player->GetGUID().GetCounter(), pending);
+  ResetTrackedWindow(player);
 }
 
 void NpcBeastmaster::ShowTrackedPetsMenu(Player *player, Creature *creature,
@@ -1127,81 +3761,116 @@ void NpcBeastmaster::ShowTrackedPetsMenu(Player *player, Creature *creature,
   ClearGossipMenuFor(player);
 
   auto &rt = BeastmasterRuntime::Instance();
+  auto state = rt.Current();
   uint64 guid = player->GetGUID().GetRawValue();
-  std::vector<std::tuple<uint32, std::string, std::string>> *trackedPetsPtr = nullptr;
+  std::vector<TrackedPetRecord> pageRows;
+  bool hasNext = false;
+  TrackedSort sort = GetTrackedSort(player);
+
+  if (state->config.trackedKeysetPaging)
   {
-    std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
-    auto it = rt.trackedPetsCache.find(guid);
-    if (it != rt.trackedPetsCache.end())
-      trackedPetsPtr = &it->second;
+    hasNext = LoadTrackedPageKeyset(player, page, pageRows);
   }
-
-  if (!trackedPetsPtr)
+  else
   {
-    if (rt.config.trackTamedPets)
+    TrackedPetList *trackedPetsPtr = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+      auto it = rt.trackedPetsCache.find(guid);
+      if (it != rt.trackedPetsCache.end())
+        trackedPetsPtr = &it->second;
+    }
+
+    if (!trackedPetsPtr && state->config.trackTamedPets)
     {
-      std::vector<std::tuple<uint32, std::string, std::string>> trackedPets;
+      std::vector<TrackedPetRecord> records;
+      std::vector<TrackedSortFields> fields;
       QueryResult result = CharacterDatabase.Query(
-          "SELECT entry, name, date_tamed FROM beastmaster_tamed_pets WHERE "
-          "owner_guid = {} ORDER BY date_tamed DESC",
+          "SELECT entry, name, UNIX_TIMESTAMP(date_tamed), last_summoned FROM "
+          "beastmaster_tamed_pets WHERE owner_guid = {}",
           player->GetGUID().GetCounter());
 
       if (result)
       {
+        records.reserve(result->GetRowCount());
+        fields.reserve(result->GetRowCount());
         do
         {
-          Field *fields = result->Fetch();
-          uint32 entry = fields[0].Get<uint32>();
-          std::string name = fields[1].Get<std::string>();
-          std::string date = fields[2].Get<std::string>();
-          trackedPets.emplace_back(entry, name, date);
+          records.push_back(ReadTrackedPetRow(result->Fetch()));
+          fields.push_back(TrackedSortFieldsFor(records.back()));
         } while (result->NextRow());
       }
       {
         std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
-        rt.trackedPetsCache[guid] = std::move(trackedPets);
-        trackedPetsPtr = &rt.trackedPetsCache[guid];
+        auto &list = rt.trackedPetsCache[guid];
+        list.Assign(std::move(records), std::move(fields));
+        trackedPetsPtr = &list;
       }
     }
-  }
-
-  const auto &trackedPets = *trackedPetsPtr;
-  uint32 total = trackedPets.size();
-  uint32 offset = (page - 1) * BeastmasterRuntime::Tracked::PageSize;
-  uint32 shown = 0;
 
-  std::map<uint32, uint32> menuPetIndexToEntry;
+    if (trackedPetsPtr)
+    {
+      std::lock_guard<std::mutex> lock(rt.trackedPetsCacheMutex);
+      const auto &trackedPets = *trackedPetsPtr;
+      size_t offset = size_t(page - 1) * BeastmasterRuntime::Tracked::PageSize;
+      size_t end = std::min(offset + BeastmasterRuntime::Tracked::PageSize,
+                            trackedPets.size());
+      trackedPets.Page(sort, offset, BeastmasterRuntime::Tracked::PageSize, pageRows);
+      hasNext = end < trackedPets.size();
+    }
+  }
 
   // Build the menu for this page
-  for (uint32 i = offset; i < total && shown < BeastmasterRuntime::Tracked::PageSize;
-       ++i, ++shown)
+  for (const auto &rec : pageRows)
   {
-    const auto &petTuple = trackedPets[i];
-    uint32 entry = std::get<0>(petTuple);
-    const std::string &name = std::get<1>(petTuple);
-    const PetInfo *info = FindPetInfo(entry);
+    uint32 entry = rec.entry;
+    const PetInfo *info = state->FindPet(entry);
+    std::string_view name = rec.HasCustomName()
+                                ? rec.CustomName()
+                                : (info ? std::string_view(info->name)
+                                        : std::string_view("Unknown"));
 
     std::string label;
     if (info)
       label =
           Acore::StringFormat("{} [{}, {}]", name, info->name, info->rarity);
     else
-      label = name;
-
-    // Use shown as the unique index for this page
-    uint32 idx = shown;
-    menuPetIndexToEntry[idx] = entry;
+      label = std::string(name);
 
-    AddGossipItemFor(player, GOSSIP_ICON_TAXI, "Summon: " + label,
-                     GOSSIP_SENDER_MAIN, BeastmasterRuntime::Tracked::SummonBase + idx);
+    AddGossipItemFor(player, GOSSIP_ICON_TAXI,
+                     Acore::StringFormat("Summon: {} ({})", label,
+                                         FormatTamedDate(rec.tamedAt)),
+                     GOSSIP_SENDER_MAIN,
+                     GossipAction::TrackedPet(ActionOp::TrackedSummon, entry));
     AddGossipItemFor(player, GOSSIP_ICON_TRAINER, "Rename: " + label,
-                     GOSSIP_SENDER_MAIN, BeastmasterRuntime::Tracked::RenameBase + idx);
+                     GOSSIP_SENDER_MAIN,
+                     GossipAction::TrackedPet(ActionOp::TrackedRename, entry));
     AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "Delete: " + label,
-                     GOSSIP_SENDER_MAIN, BeastmasterRuntime::Tracked::DeleteBase + idx);
+                     GOSSIP_SENDER_MAIN,
+                     GossipAction::TrackedPet(ActionOp::TrackedDelete, entry));
+  }
+
+  // 9 pets x 3 actions leaves room for the sort toggle and two navigation
+  // items. Keyset paging streams the date order from the DB, so it has no
+  // other orders.
+  if (!state->config.trackedKeysetPaging)
+  {
+    static constexpr char const *SortNames[] = {"Tame Date", "Name", "Family", "Rarity",
+                                                "Last Summoned"};
+    static_assert(std::size(SortNames) == size_t(TrackedSort::Count));
+    uint32 next = (uint32(sort) + 1) % uint32(TrackedSort::Count);
+    AddGossipItemFor(player, GOSSIP_ICON_TALK,
+                     Acore::StringFormat("Sorted by {} (change)", SortNames[size_t(sort)]),
+                     GOSSIP_SENDER_MAIN, GossipAction::TrackedPage(1, next + 1));
   }
-  // Store the mapping for this menu page
-  player->CustomData.Set("BeastmasterMenuPetMap",
-                         new BeastmasterPetMap(menuPetIndexToEntry));
+  if (page > 1)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Previous..",
+                     GOSSIP_SENDER_MAIN,
+                     GossipAction::TrackedPage(page - 1));
+  if (hasNext && page < GossipAction::MaxPage)
+    AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, "Next..",
+                     GOSSIP_SENDER_MAIN,
+                     GossipAction::TrackedPage(page + 1));
 
   // Send the menu to the player
   if (creature)
@@ -1213,7 +3882,10 @@ void NpcBeastmaster::ShowTrackedPetsMenu(Player *player, Creature *creature,
 void NpcBeastmaster::PlayerUpdate(Player *player)
 {
   auto &rt = BeastmasterRuntime::Instance();
-  if (rt.config.keepPetHappy && player->GetPet())
+  if (rt.hasNotices.load(std::memory_order_relaxed))
+    DeliverNotices(player);
+
+  if (rt.keepPetHappy.load(std::memory_order_relaxed) && player->GetPet())
   {
     Pet *pet = player->GetPet();
     if (pet->getPetType() == HUNTER_PET)
@@ -1240,6 +3912,14 @@ public:
     return true;
   }
 
+  bool OnGossipSelectCode(Player *player, Creature *creature,
+                          uint32 /*sender*/, uint32 action,
+                          char const *code) override
+  {
+    sNpcBeastMaster->GossipSelectCode(player, creature, action, code);
+    return true;
+  }
+
   struct beastmasterAI : public ScriptedAI
   {
     beastmasterAI(Creature *creature) : ScriptedAI(creature) {}
@@ -1277,12 +3957,24 @@ class BeastMaster_WorldScript : public WorldScript
 public:
   BeastMaster_WorldScript()
       : WorldScript("BeastMaster_WorldScript",
-                    {WORLDHOOK_ON_BEFORE_CONFIG_LOAD}) {}
+                    {WORLDHOOK_ON_BEFORE_CONFIG_LOAD,
+                     WORLDHOOK_ON_UPDATE,
+                     WORLDHOOK_ON_SHUTDOWN}) {}
 
   void OnBeforeConfigLoad(bool /*reload*/) override
   {
     sNpcBeastMaster->LoadSystem();
   }
+
+  void OnUpdate(uint32 diff) override
+  {
+    sNpcBeastMaster->WorldUpdate(diff);
+  }
+
+  void OnShutdown() override
+  {
+    sNpcBeastMaster->WaitForLoad();
+  }
 };
 
 class BeastMaster_PlayerScript : public PlayerScript
@@ -1292,7 +3984,14 @@ public:
       : PlayerScript("BeastMaster_PlayerScript",
                      {PLAYERHOOK_ON_BEFORE_UPDATE,
                       PLAYERHOOK_ON_BEFORE_LOAD_PET_FROM_DB,
-                      PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL}) {}
+                      PLAYERHOOK_ON_BEFORE_GUARDIAN_INIT_STATS_FOR_LEVEL,
+                      PLAYERHOOK_ON_LEVEL_CHANGED,
+                      PLAYERHOOK_ON_LEARN_TALENTS,
+                      PLAYERHOOK_ON_TALENTS_RESET,
+                      PLAYERHOOK_ON_AFTER_SPEC_SLOT_CHANGED,
+                      PLAYERHOOK_ON_LEARN_SPELL,
+                      PLAYERHOOK_ON_FORGOT_SPELL,
+                      PLAYERHOOK_ON_LOGOUT}) {}
 
   void OnPlayerBeforeUpdate(Player *player, uint32 /*p_time*/) override
   {
@@ -1306,6 +4005,43 @@ public:
     forceLoadFromDB = true;
   }
 
+  // Anything that can change class/level gating or Beast Mastery / Call Pet
+  // ownership drops the cached eligibility bits.
+  void OnPlayerLevelChanged(Player *player, uint8 /*oldLevel*/) override
+  {
+    sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
+  void OnPlayerLearnTalents(Player *player, uint32 /*talentId*/,
+                            uint32 /*talentRank*/, uint32 /*spellId*/) override
+  {
+    sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
+  void OnPlayerTalentsReset(Player *player, bool /*noCost*/) override
+  {
+    sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
+  void OnPlayerAfterSpecSlotChanged(Player *player, uint8 /*newSlot*/) override
+  {
+    sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
+  void OnPlayerLearnSpell(Player *player, uint32 spellId) override
+  {
+    if (spellId == BeastmasterRuntime::PET_SPELL_BEAST_MASTERY ||
+        spellId == BeastmasterRuntime::PET_SPELL_CALL_PET)
+      sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
+  void OnPlayerForgotSpell(Player *player, uint32 spellId) override
+  {
+    if (spellId == BeastmasterRuntime::PET_SPELL_BEAST_MASTERY ||
+        spellId == BeastmasterRuntime::PET_SPELL_CALL_PET)
+      sNpcBeastMaster->InvalidateEligibility(player);
+  }
+
   void OnPlayerBeforeGuardianInitStatsForLevel(Player * /*player*/,
                                                Guardian * /*guardian*/,
                                                CreatureTemplate const *cinfo,
@@ -1314,6 +4050,12 @@ public:
     if (cinfo->IsTameable(true))
       petType = HUNTER_PET;
   }
+
+  // Drops the tracked pets cache, writing back pending summon times.
+  void OnPlayerLogout(Player *player) override
+  {
+    sNpcBeastMaster->ClearTrackedPetsCache(player);
+  }
 };
 
 // Rename and cancel commands for pet renaming
@@ -1335,6 +4077,8 @@ public:
   static bool HandlePetnameCancelCommand(ChatHandler *handler,
                                          std::string_view args);
   static bool HandleBeastmasterCommand(ChatHandler *handler, const char *args);
+  static bool HandleBeastmasterFindCommand(ChatHandler *handler,
+                                           std::string_view args);
 };
 
 // Adaptor functions must be at namespace (file) scope in C++; nested function
@@ -1353,6 +4097,10 @@ namespace
   {
     return BeastMaster_CommandScript::HandleBeastmasterCommand(handler, args ? args : "");
   }
+  static bool BeastmasterFindAdaptor(ChatHandler *handler, char const *args)
+  {
+    return BeastMaster_CommandScript::HandleBeastmasterFindCommand(handler, args ? args : "");
+  }
   static bool BeastmasterReloadAdaptor(ChatHandler *handler, char const * /*args*/)
   {
     if (handler->GetSession() && handler->GetSession()->GetSecurity() < SEC_GAMEMASTER && !handler->IsConsole())
@@ -1360,8 +4108,28 @@ namespace
       handler->PSendSysMessage("Insufficient privileges.");
       return true;
     }
-    sNpcBeastMaster->LoadSystem(true);
-    handler->PSendSysMessage("Beastmaster configuration & pet lists reloaded.");
+    // Console output is not tied to a session, so only players get a notice.
+    Player *gm = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr;
+    uint64 gmGuid = gm ? gm->GetGUID().GetRawValue() : 0;
+    bool started = sNpcBeastMaster->LoadSystem(
+        true, [gmGuid](BeastmasterLoadResult const &result)
+        {
+          if (!gmGuid)
+            return;
+          QueuePlayerNotice(
+              gmGuid,
+              result.success
+                  ? Acore::StringFormat("Beastmaster reload finished in {} ms ({} pets).",
+                                        result.durationMs, result.pets)
+                  : Acore::StringFormat("Beastmaster reload failed after {} ms; previous pet lists kept.",
+                                        result.durationMs));
+        });
+    if (!started)
+    {
+      handler->PSendSysMessage("A Beastmaster reload is already in progress.");
+      return true;
+    }
+    handler->PSendSysMessage("Beastmaster configuration & pet lists reloading in the background.");
     LOG_INFO("module", "Beastmaster: Reload triggered via .beastmaster reload");
     return true;
   }
@@ -1377,12 +4145,17 @@ Acore::ChatCommands::ChatCommandTable BeastMaster_CommandScript::GetCommands() c
       ChatCommandBuilder("cancel", PetnameCancelAdaptor, SEC_PLAYER, Console::No)};
 
   static ChatCommandTable beastmasterSub = {
-      ChatCommandBuilder("reload", BeastmasterReloadAdaptor, SEC_PLAYER, Console::Yes)};
+      ChatCommandBuilder("reload", BeastmasterReloadAdaptor, SEC_PLAYER, Console::Yes),
+      ChatCommandBuilder("find", BeastmasterFindAdaptor, SEC_PLAYER, Console::Yes)};
+
+  static ChatCommandTable bmSub = {
+      ChatCommandBuilder("find", BeastmasterFindAdaptor, SEC_PLAYER, Console::Yes)};
 
   static ChatCommandTable root = {
       ChatCommandBuilder("beastmaster", BeastmasterSummonAdaptor, SEC_PLAYER, Console::Yes), // main command to summon NPC
       ChatCommandBuilder("bm", BeastmasterSummonAdaptor, SEC_PLAYER, Console::Yes),          // short alias
-      ChatCommandBuilder("beastmaster", beastmasterSub),                                     // subcommands (.beastmaster reload)
+      ChatCommandBuilder("beastmaster", beastmasterSub),                                     // subcommands (.beastmaster reload/find)
+      ChatCommandBuilder("bm", bmSub),                                                       // .bm find
       ChatCommandBuilder("petname", petnameSub)};                                            // pet name utilities
   return root;
 }
@@ -1422,16 +4195,70 @@ bool BeastMaster_CommandScript::HandlePetnameRenameCommand(
     return true;
   }
 
+  uint32 entry = renameEntry->value;
   CharacterDatabase.Execute("UPDATE beastmaster_tamed_pets SET name = '{}' "
                             "WHERE owner_guid = {} AND entry = {}",
-                            newName, player->GetGUID().GetCounter(),
-                            renameEntry->value);
+                            newName, player->GetGUID().GetCounter(), entry);
 
   player->CustomData.Erase("BeastmasterExpectRename");
   player->CustomData.Erase("BeastmasterRenamePetEntry");
 
   handler->PSendSysMessage("Pet renamed to '{}'.", newName);
-  sNpcBeastMaster->ClearTrackedPetsCache(player);
+  TrackedCacheRename(player->GetGUID().GetRawValue(), entry, newName);
+  if (auto *win = GetTrackedWindow(player))
+    for (auto &r : win->rows)
+      if (r.entry == entry)
+        r.SetName(newName);
+  return true;
+}
+
+bool BeastMaster_CommandScript::HandleBeastmasterFindCommand(
+    ChatHandler *handler, std::string_view args)
+{
+  std::string query = NormalizeSearchKey(args.substr(0, 64));
+  if (query.empty())
+  {
+    handler->PSendSysMessage("Usage: .bm find <pet name>");
+    return true;
+  }
+
+  auto &rt = BeastmasterRuntime::Instance();
+  if (!rt.ready.load(std::memory_order_acquire))
+  {
+    handler->PSendSysMessage(rt.loadFailed.load(std::memory_order_acquire)
+                                 ? "The Beastmaster pet list failed to load; check beastmaster_tames."
+                                 : "The Beastmaster pet list is still loading.");
+    return true;
+  }
+
+  // Players only see what they could adopt; the console sees everything.
+  Player *player = handler->GetSession() ? handler->GetSession()->GetPlayer() : nullptr;
+  bool exotic = !player || (GetEligibility(player) & ELIGIBLE_EXOTIC);
+  LocaleConstant locale = player ? player->GetSession()->GetSessionDbLocaleIndex() : LOCALE_enUS;
+
+  auto state = rt.Current();
+  std::vector<BeastmasterRuntime::State::PetSlot> slots;
+  for (PetInfo const *pet : SearchPetsByPrefix(*state, locale, query, exotic))
+  {
+    slots.push_back(state->petSlots->at(pet->entry));
+    if (slots.size() >= 10)
+      break;
+  }
+  if (slots.empty())
+    slots = FuzzySearchPets(*state, locale, query, exotic, 10);
+
+  if (slots.empty())
+  {
+    handler->PSendSysMessage("No pets found matching '{}'.", query);
+    return true;
+  }
+  handler->PSendSysMessage("Pets matching '{}':", query);
+  for (auto const &slot : slots)
+  {
+    PetInfo const &pet = state->CategoryPets(slot.category)[slot.index];
+    handler->PSendSysMessage("  {} (entry {}, {})", state->PetName(pet, locale), pet.entry,
+                             PetCategoryName(slot.category));
+  }
   return true;
 }
 
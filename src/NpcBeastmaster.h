@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include <algorithm> // For std::sort
+#include <functional>
 #include <map>
 #include <mutex>
 #include <tuple>
@@ -41,6 +42,22 @@ struct PetInfo
   uint32 family;
   std::string rarity;
   uint32 icon; // e.g. "Ability_Hunter_Pet_Wolf"
+  uint8 minLevel = 0; // creature_template levels, 0 if unknown
+  uint8 maxLevel = 0;
+  std::string sortKey; // folded name for ordering, filled when the catalog is built
+
+  bool operator==(PetInfo const &) const = default;
+};
+
+/**
+ * BeastmasterLoadResult
+ * Outcome of a background LoadSystem, passed to its completion callback.
+ */
+struct BeastmasterLoadResult
+{
+  bool success = false; // false keeps the previously published state
+  uint32 pets = 0;
+  uint32 durationMs = 0;
 };
 
 /**
@@ -65,19 +82,46 @@ public:
    */
   static NpcBeastmaster *instance();
 
+  using LoadCallback = std::function<void(BeastmasterLoadResult const &)>;
+
   /**
-   * Loads all configuration options and pets from JSON and config.
-   * Thread-safe for global pet lists.
+   * Loads all configuration options and pets on a background thread and
+   * publishes them atomically; the previous state is served until then.
+   * reload (.beastmaster reload) also marks the pet catalog changed so it is
+   * re-read even after edits the change triggers miss. onComplete runs on
+   * the loader thread. Returns false (and does not call onComplete) if a
+   * load is already in progress.
    */
-  void LoadSystem(bool reload = false);
+  bool LoadSystem(bool reload = false, LoadCallback onComplete = {});
+
+  /**
+   * Blocks until a background load in progress has finished (shutdown).
+   */
+  void WaitForLoad();
+
+  /**
+   * World tick. When BeastMaster.CatalogPollInterval is set, periodically
+   * checks beastmaster_tames for changes on the loader thread and refreshes
+   * the pet catalog if it changed.
+   */
+  void WorldUpdate(uint32 diff);
 
   // Gossip menu logic
   void ShowMainMenu(Player *player, Creature *creature);
   void GossipSelect(Player *player, Creature *creature, uint32 action);
+  void GossipSelectCode(Player *player, Creature *creature, uint32 action,
+                        char const *code);
 
   // Player update logic (e.g., keep pet happy)
   void PlayerUpdate(Player *player);
 
+  /**
+   * Drops the player's cached eligibility bits (allowed, exotic access,
+   * Beast Mastery teach, unlearn). Called from level/talent/spec/spell hooks;
+   * the bits are recomputed on the next menu interaction.
+   */
+  void InvalidateEligibility(Player *player);
+
   /**
    * Clears the tracked pets cache for a specific player.
    * Thread-safe.
@@ -89,28 +133,48 @@ public:
    */
   void ShowTrackedPetsMenu(Player *player, Creature *creature, uint32 page = 1);
 
+  /**
+   * Sorts pets by their precomputed collation key and then by entry, so
+   * equal catalogs always sort the same way. Catalog lists are kept in this
+   * order.
+   */
+  static void SortPetsByName(std::vector<PetInfo> &pets)
+  {
+    std::sort(
+        pets.begin(), pets.end(),
+        [](const PetInfo &a, const PetInfo &b)
+        { return std::tie(a.sortKey, a.entry) < std::tie(b.sortKey, b.entry); });
+  }
+
 private:
   // Handles pet creation/adoption for the player.
   void CreatePet(Player *player, Creature *creature, uint32 action);
 
-  // Adds pets to the gossip menu for the given page.
-  void AddPetsToGossip(Player *player, std::vector<PetInfo> const &pets,
-                       uint32 page);
+  // Adds one page of pets to the gossip menu.
+  void AddPetsToGossip(Player *player, std::vector<PetInfo const *> const &pets);
+
+  // Gossip action handlers, dispatched by opcode from GossipSelect. Each
+  // receives the encoded action word.
+  void HandleRawAction(Player *player, Creature *creature, uint32 action);
+  void HandleMainMenuAction(Player *player, Creature *creature, uint32 action);
+  void HandleBrowseAction(Player *player, Creature *creature, uint32 action);
+  void HandleRemoveSkills(Player *player, Creature *creature, uint32 action);
+  void HandleTrackedMenu(Player *player, Creature *creature, uint32 action);
+  void HandleSummonPet(Player *player, Creature *creature, uint32 action);
+  void HandleSearchAction(Player *player, Creature *creature, uint32 action);
+  void HandleFamilyAction(Player *player, Creature *creature, uint32 action);
+  void HandleLettersAction(Player *player, Creature *creature, uint32 action);
+  void HandleNearbyAction(Player *player, Creature *creature, uint32 action);
+
+  // Teaches Beast Mastery if needed before exotic pets are shown; false if
+  // the player may not see exotic pets.
+  bool GrantExoticAccess(Player *player, Creature *creature);
 
   // Handles the rename prompt for pets.
-  void HandleRenamePet(Player *player, Creature *creature, uint32 entry);
+  void HandleRenamePet(Player *player, Creature *creature, uint32 action);
 
   // Handles the delete confirmation for pets.
-  void HandleDeletePet(Player *player, Creature *creature, uint32 entry);
-
-  // Sorts pets by name (utility).
-  void SortPetsByName(std::vector<PetInfo> &normalPets)
-  {
-    std::sort(
-        normalPets.begin(), normalPets.end(),
-        [](const PetInfo &a, const PetInfo &b)
-        { return a.name < b.name; });
-  }
+  void HandleDeletePet(Player *player, Creature *creature, uint32 action);
 };
 
 #define sNpcBeastMaster NpcBeastmaster::instance()